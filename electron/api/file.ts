@@ -1,5 +1,6 @@
 import { ipcMain, BrowserWindow } from 'electron';
-import { searchFiles, shortSearch } from '../core/search.js';
+import { searchFiles } from '../core/search.js';
+import { sessionShortSearch } from '../core/searchSession.js';
 import { init, sendToRenderer, startIndexTask } from '../main.js';
 import { openDir } from '../core/system.js';
 import { setOpenIndexImages } from '../core/appState.js';
@@ -33,8 +34,8 @@ export function initializeFileApi(mainWindow: BrowserWindow) {
 
     // 搜索文件
     ipcMain.handle('search-files', (_event, keyword: string) => searchFiles(keyword));
-    // 快捷搜索
-    ipcMain.handle('short-search', (_event, keyword: string,fileType:string) => shortSearch(keyword,fileType));
+    // 快捷搜索（按窗口维护输入会话，逐字输入时复用上一次的结果）
+    ipcMain.handle('short-search', (event, keyword: string,fileType:string) => sessionShortSearch(event.sender, keyword, fileType));
 
     // 打开某个路径（📌，需要取代open-file-location）
     ipcMain.on('open-dir', (event, type, path) => { openDir(type, path) });
@@ -0,0 +1,147 @@
+/**
+ * 文件名拼写容错
+ * 基于原生模块 fuzzy_search（SymSpell 删除索引 + 位并行 OSA 编辑距离），
+ * 用 files.name 中去重后的词构建词典，为搜索词中的错拼（如 reprot）给出纠正
+ */
+import * as fs from 'fs';
+import { createRequire } from 'module';
+import pathConfig from './pathConfigs.js';
+import { getDatabase } from '../database/sqlite.js';
+import { logger } from './logger.js';
+
+const require = createRequire(import.meta.url);
+
+// 每批读取并传给原生模块切词的文件名数，批与批之间主线程可以处理其他任务
+const NAME_BATCH_SIZE = 5000;
+
+interface FuzzySuggestion {
+  term: string;
+  distance: number;
+  count: number;
+}
+
+interface NativeFuzzyModule {
+  addNames(names: string, reset?: boolean): Promise<number>;
+  commitIndex(): Promise<number>;
+  suggest(term: string, maxDistance?: number, limit?: number): FuzzySuggestion[];
+  hasPrefix(term: string): boolean;
+  isReady(): boolean;
+}
+
+let nativeModule: NativeFuzzyModule | null = null;
+let loadFailed = false; // 加载失败后不再重复尝试，避免每次按键都访问磁盘
+let indexStale = true; // 文件表有变化，需要重建词典
+let building: Promise<void> | null = null;
+
+
+/**
+ * 加载原生模块（同步，搜索路径上调用）
+ * @returns 加载成功的原生模块实例，失败返回null
+ */
+function loadNativeModule(): NativeFuzzyModule | null {
+  if (nativeModule || loadFailed) {
+    return nativeModule;
+  }
+  const modulePath = pathConfig.get('fuzzySearch');
+  try {
+    if (!fs.existsSync(modulePath)) {
+      throw new Error(`模块不存在: ${modulePath}`);
+    }
+    nativeModule = require(modulePath);
+    logger.info(`成功加载模糊匹配模块: ${modulePath}`);
+  } catch (error) {
+    loadFailed = true;
+    const msg = error instanceof Error ? error.message : '模块加载失败';
+    logger.warn(`模糊匹配模块不可用，搜索将不做拼写容错: ${msg}`);
+  }
+  return nativeModule;
+}
+
+
+/**
+ * 标记词典过期（新文件入库后调用；已有记录更新时文件名不变，不需要调用），下次搜索时在后台重建；正在构建时，构建结束后再重建一次
+ */
+export function markFuzzyIndexStale(): void {
+  indexStale = true;
+}
+
+
+/**
+ * 从 files.name 重建模糊匹配词典
+ * 文件名按 id 分批读取，切词与建索引在原生模块的后台线程进行，构建期间继续使用旧词典
+ */
+export function rebuildFuzzyIndex(): Promise<void> {
+  const module = loadNativeModule();
+  if (!module) return Promise.resolve();
+  if (building) {
+    // 构建开始后文件表又有变化，本次构建结束后再重建一次
+    indexStale = true;
+    return building;
+  }
+
+  indexStale = false;
+  building = (async () => {
+    let succeeded = false;
+    try {
+      const startTime = Date.now();
+      const selectBatch = getDatabase().prepare(`SELECT id, name FROM files WHERE id > ? ORDER BY id LIMIT ?`);
+      let lastId = 0;
+      let nameCount = 0;
+      let rows: { id: number; name: string }[];
+      do {
+        rows = selectBatch.all(lastId, NAME_BATCH_SIZE) as { id: number; name: string }[];
+        // 第一批丢弃上次未完成的构建
+        await module.addNames(rows.map(row => row.name).join('\n'), nameCount === 0);
+        if (rows.length > 0) lastId = rows[rows.length - 1].id;
+        nameCount += rows.length;
+      } while (rows.length === NAME_BATCH_SIZE);
+      const termCount = await module.commitIndex();
+      succeeded = true;
+      logger.info(`模糊匹配词典构建完成: ${nameCount} 个文件名，${termCount} 个词，耗时 ${Date.now() - startTime} 毫秒`);
+    } catch (error) {
+      indexStale = true;
+      logger.error(`模糊匹配词典构建失败: ${error}`);
+    } finally {
+      building = null;
+    }
+    // 失败时不立即重试，等下次搜索再触发
+    if (succeeded && indexStale) {
+      await rebuildFuzzyIndex();
+    }
+  })();
+  return building;
+}
+
+
+/**
+ * 纠正搜索词中的错拼
+ * 逐个空格分隔的词查询词典：是词典中某个词的前缀（含完整的词）时保持不变，否则替换为编辑距离最小、出现次数最多的词
+ * 逐字输入时未输完的词（如 quarte）是 quarterly 的前缀，搜索本身已能按前缀匹配，不能当作错拼
+ * @param searchTerm 搜索关键词
+ * @returns 纠正后的搜索词；无需纠正或词典不可用时返回 null
+ */
+export function correctSearchTerm(searchTerm: string): string | null {
+  const module = loadNativeModule();
+  if (!module) return null;
+  if (indexStale) {
+    void rebuildFuzzyIndex();
+  }
+  if (!module.isReady()) return null;
+
+  let changed = false;
+  const corrected = searchTerm
+    .trim()
+    .split(/\s+/)
+    .map(token => {
+      if (token.length < 3 || module.hasPrefix(token)) return token;
+      // 短词只容忍 1 处错误，避免纠正成不相关的词
+      const maxDistance = token.length <= 4 ? 1 : 2;
+      const [best] = module.suggest(token, maxDistance, 1);
+      if (!best || best.distance === 0) return token;
+      changed = true;
+      return best.term;
+    })
+    .join(' ');
+
+  return changed ? corrected : null;
+}
@@ -21,6 +21,9 @@ import { normalizeWinPath } from '../units/pathUtils.js';
 import { shell } from 'electron';
 import { pinyin } from 'pinyin-pro';
 import { calculateMd5 } from '../units/math.js';
+import { rebuildFuzzyIndex } from './fuzzyMatcher.js';
+import { invalidateSearchSessions } from './searchSession.js';
+import { repairUndecodableContent } from '../database/contentCodec.js';
 
 type FileInfo = {
     filePath: string;
@@ -128,8 +131,15 @@ const deleteExtraFiles = async (allFiles: FileInfo[]) => {
             }
         });
 
-        // 执行事务
-        deleteTransaction(filesToDelete);
+        // 执行事务；正文无法解压会中止删除（FTS 删除需要原正文），修复后重试一次
+        try {
+            deleteTransaction(filesToDelete);
+        } catch (error) {
+            const repaired = repairUndecodableContent(db);
+            if (repaired === 0) throw error;
+            logger.warn(`删除过时记录失败，已清空 ${repaired} 条无法解压的正文并重建全文索引，重试删除: ${error}`);
+            deleteTransaction(filesToDelete);
+        }
         logger.info('过时的文件记录已成功删除。');
     } else {
         logger.info('数据库与文件系统一致，无需删除。');
@@ -162,7 +172,7 @@ export async function indexAllFilesWithWorkers(): Promise<FileInfo[]> {
             const workerPath = path.join(__dirname, '../workers/indexer.worker.js');
 
             const worker = new Worker(workerPath, {
-                workerData: { drive, dbPath }
+                workerData: { drive, dbPath, contentCodecPath: pathConfig.get('contentCodec') }
             });
 
             worker.on('message', (message) => {
@@ -279,6 +289,9 @@ export async function indexAllFilesWithWorkers(): Promise<FileInfo[]> {
 
         const endTime = Date.now();
         logger.info(`所有 Worker 线程索引完成。共找到 ${allFiles.length} 个文件，耗时: ${endTime - startTime} 毫秒`);
+        // 文件名有变化，后台重建拼写容错词典，并清空快捷搜索缓存
+        void rebuildFuzzyIndex();
+        invalidateSearchSessions();
 
 
 
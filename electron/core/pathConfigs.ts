@@ -23,6 +23,8 @@ interface PathsConfig {
     ollamaPath: string;
     iconsCache: string;
     iconExtractor: string;
+    fuzzySearch: string;
+    contentCodec: string;
     getPrograms: string;
     recentFolder: string;
 }
@@ -44,6 +46,8 @@ class PathConfig {
     private resources: string;
     private ollamaPath: string;
     private iconExtractor: string;
+    private fuzzySearch: string;
+    private contentCodec: string;
     private recentFolder: string;
     private appData: string;
 
@@ -67,6 +71,16 @@ class PathConfig {
             path.join(this.resources, 'native', 'dist', 'win32-x64-139', 'icon_extractor.node')
             : path.join(__dirname, '..', 'native', 'dist', 'win32-x64-139', 'icon_extractor.node')
 
+        // C++ 文件名模糊匹配模块
+        this.fuzzySearch = app.isPackaged ?
+            path.join(this.resources, 'native', 'dist', 'win32-x64-139', 'fuzzy_search.node')
+            : path.join(__dirname, '..', 'native', 'dist', 'win32-x64-139', 'fuzzy_search.node')
+
+        // C++ 文档正文压缩模块
+        this.contentCodec = app.isPackaged ?
+            path.join(this.resources, 'native', 'dist', 'win32-x64-139', 'content_codec.node')
+            : path.join(__dirname, '..', 'native', 'dist', 'win32-x64-139', 'content_codec.node')
+
         // 最近的访问目录 （还缺少mac）
         this.recentFolder = process.platform === 'win32'
             ? path.join(this.appData, 'Microsoft', 'Windows', 'Recent')
@@ -108,6 +122,12 @@ class PathConfig {
             // 图标提取器
             iconExtractor: this.iconExtractor,
 
+            // 文件名模糊匹配
+            fuzzySearch: this.fuzzySearch,
+
+            // 文档正文压缩
+            contentCodec: this.contentCodec,
+
             // 程序列表脚本(后期归到服务脚本文件夹)
             getPrograms: path.join(this.resources, 'get_programs.ps1'),
 
@@ -117,6 +137,8 @@ class PathConfig {
 
         //确保所有目录都存在
         Object.values(this.paths).forEach(dir => {
+            // 原生模块是文件，未编译时不能为其创建同名目录
+            if (path.extname(dir) === '.node') return;
             if (!fs.existsSync(dir)) {
                 fs.mkdirSync(dir, { recursive: true });
             }
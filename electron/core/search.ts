@@ -4,16 +4,59 @@ import { logger } from './logger.js';
 import { waitForModelReady } from './appState.js';
 import { aiSeverSingleton } from '../sever/aiSever.js';
 import { ollamaService } from '../sever/ollamaSever.js';
+import { correctSearchTerm } from './fuzzyMatcher.js';
 import { describe } from 'node:test';
 
+// 原词结果少于该数量时，才尝试拼写纠正补充结果
+const FUZZY_FALLBACK_THRESHOLD = 5;
+
+
+// 名称/摘要/标签的子串匹配条件，与 findFileCandidates 共用，保证两处的候选集合一致
+const FILE_TEXT_MATCH = `(
+         lower(f.name) LIKE '%' || @query || '%'
+         OR lower(f.summary) LIKE '%' || @query || '%'
+         OR lower(f.tags) LIKE '%' || @query || '%'
+      )`;
+
+
+/**
+ * 拼写纠正结果缓存：纠正后的词（含分类）-> 该词的完整搜索结果
+ * 由输入会话持有，逐字输入一个少见的文件名时，相邻的按键常纠正为同一个词，无需重复全表查询
+ */
+export type CorrectionCache = Map<string, SearchDataItem[]>;
+
+
+/**
+ * 查找名称/摘要/标签包含关键词的文件 id（不含 FTS 命中）
+ * 传入上一个关键词的候选时只在候选内过滤：新关键词包含旧关键词时，其匹配结果必然是旧结果的子集
+ * @param searchTerm 搜索关键词
+ * @param withinIds 上一次的候选 id，不传则扫描全表
+ * @param max 候选上限，超过时返回 null（候选太多时缩小范围已无意义）
+ */
+export function findFileCandidates(searchTerm: string, withinIds: number[] | null, max: number): number[] | null {
+  const db = getDatabase();
+  const stmt = db.prepare(`
+    SELECT f.id FROM files f
+    WHERE ${withinIds ? 'f.id IN (SELECT value FROM json_each(@candidates)) AND' : ''} ${FILE_TEXT_MATCH}
+    LIMIT @max
+  `).pluck();
+  const ids = stmt.all({
+    query: searchTerm.toLowerCase(),
+    max: max + 1,
+    ...(withinIds ? { candidates: JSON.stringify(withinIds) } : {}),
+  }) as number[];
+  return ids.length > max ? null : ids;
+}
 
 
 /**
  * 搜索文件，支持模糊搜索和近似搜索。
  * @param searchTerm 搜索关键词
+ * @param candidateIds 由 findFileCandidates 得到的候选 id，传入时不再全表扫描名称/摘要/标签
+ * @param corrections 拼写纠正结果缓存，由输入会话传入
  * @returns 匹配到的文件列表，按匹配度排序
  */
-export function searchFiles(searchTerm: string, fileType?: string, limit?: number): shortSearchResult {
+export function searchFiles(searchTerm: string, fileType?: string, limit?: number, candidateIds?: number[], corrections?: CorrectionCache): shortSearchResult {
   if (!searchTerm) {
     return {
       data: [],
@@ -31,7 +74,7 @@ export function searchFiles(searchTerm: string, fileType?: string, limit?: numbe
   }
   const db = getDatabase()
 
-  // 步骤1：计算 FTS 候选上限（作用：控制 snippet 的生成数量）
+  // 步骤1：计算 FTS 候选上限（作用：控制参与排序的全文命中数量）
   const ftsLimit = Math.min(Math.max(limit ?? 200, 50), 500);
   // 拆分为单字的方法（用于 FTS5 前缀查询，FTS5会把每个字作为一个 token，作为倒排）
   const buildFtsQuery = (input: string) => {
@@ -59,21 +102,22 @@ export function searchFiles(searchTerm: string, fileType?: string, limit?: numbe
     * Rec: 最近访问（last_access_time 线性衰减：0.5天=1，90天=0）
     * Len: 长度惩罚（短名更高）
     */
-    const stmt = db.prepare(`
-      WITH q(query) AS (SELECT lower(?)),
+    const buildStatement = (restricted: boolean) => db.prepare(`
+      WITH q(query) AS (SELECT lower(@query)),
       -- 临时结果集 ftsHits：只去 FTS5 虚拟表里做全文检索
+      -- 不在这里生成 snippet：CTE 会物化，snippet（需解压正文）会对每个命中都计算一次
       ftsHits AS (
         SELECT 
           rowid,
-          snippet(files_fts, 0, '<mark>', '</mark>', '...', 16) AS snippet,
           bm25(files_fts) AS fts_score
         FROM files_fts
-    -- 第二个参数 匹配全文
-        WHERE files_fts MATCH ?
+    -- 匹配全文
+        WHERE files_fts MATCH @fts
         ORDER BY bm25(files_fts)
-    -- 第三个参数 限制返回数量
-        LIMIT ?
-      )
+    -- 限制返回数量
+        LIMIT @ftsLimit
+      ),
+      ranked AS (
       SELECT 
         f.id, f.path, f.name, f.modified_at, f.last_access_time, f.ext, f.summary, f.ai_mark, f.click_count,
         (
@@ -94,30 +138,66 @@ export function searchFiles(searchTerm: string, fileType?: string, limit?: numbe
           )
         + 0.04 * (1.0 - MIN(length(f.name), 255) / 255.0)
         ) AS score,
-        ftsHits.snippet AS snippet
+        ftsHits.rowid AS fts_rowid
       FROM files f
       LEFT JOIN ftsHits ON ftsHits.rowid = f.id
       CROSS JOIN q
-      WHERE (
-         lower(f.name) LIKE '%' || q.query || '%'
-         OR lower(f.summary) LIKE '%' || q.query || '%'
-         OR lower(f.tags) LIKE '%' || q.query || '%'
-         OR ftsHits.rowid IS NOT NULL
-      )
+      WHERE ${restricted
+        // 候选 id 与 FTS 命中都走主键查找，避免全表扫描
+        ? `f.id IN (SELECT value FROM json_each(@candidates) UNION SELECT rowid FROM ftsHits)`
+        : `(${FILE_TEXT_MATCH} OR ftsHits.rowid IS NOT NULL)`}
       AND (
-         ? = 'ALL' OR
-         (? = 'APP' AND f.ext IN ('.exe', '.lnk', '.app')) OR
-         (? = 'DOC' AND f.ext IN ('.pdf', '.doc', '.docx', '.txt', '.md', '.ppt', '.pptx', '.xls', '.xlsx')) OR
-         (? = 'IMAGE' AND f.ext IN ('.jpg', '.jpeg', '.png', '.gif', '.bmp', '.svg', '.webp', '.ico')) OR
-         (? = 'OTHER' AND f.ext NOT IN ('.exe', '.lnk', '.app', '.pdf', '.doc', '.docx', '.txt', '.md', '.ppt', '.pptx', '.xls', '.xlsx', '.jpg', '.jpeg', '.png', '.gif', '.bmp', '.svg', '.webp', '.ico'))
+         @fileType = 'ALL' OR
+         (@fileType = 'APP' AND f.ext IN ('.exe', '.lnk', '.app')) OR
+         (@fileType = 'DOC' AND f.ext IN ('.pdf', '.doc', '.docx', '.txt', '.md', '.ppt', '.pptx', '.xls', '.xlsx')) OR
+         (@fileType = 'IMAGE' AND f.ext IN ('.jpg', '.jpeg', '.png', '.gif', '.bmp', '.svg', '.webp', '.ico')) OR
+         (@fileType = 'OTHER' AND f.ext NOT IN ('.exe', '.lnk', '.app', '.pdf', '.doc', '.docx', '.txt', '.md', '.ppt', '.pptx', '.xls', '.xlsx', '.jpg', '.jpeg', '.png', '.gif', '.bmp', '.svg', '.webp', '.ico'))
       )
       ORDER BY f.ai_mark DESC, score DESC, f.name
       LIMIT 50
+      )
+      -- 只为最终返回的 50 条生成 snippet：按 rowid 定位，每条只解压一篇正文
+      SELECT
+        ranked.id, ranked.path, ranked.name, ranked.modified_at, ranked.last_access_time, ranked.ext, ranked.summary, ranked.ai_mark, ranked.click_count, ranked.score,
+        CASE WHEN ranked.fts_rowid IS NOT NULL THEN (
+          SELECT snippet(files_fts, 0, '<mark>', '</mark>', '...', 16) FROM files_fts
+          WHERE files_fts MATCH @fts AND rowid = ranked.fts_rowid
+        ) END AS snippet
+      FROM ranked
+      ORDER BY ranked.ai_mark DESC, ranked.score DESC, ranked.name
     `);
     const q = searchTerm.toLowerCase();
     const fileTypeFilter = fileType || 'ALL';
     console.log('fileTypeFilter', fileTypeFilter)
-    const allFiles = stmt.all(q, ftsQuery, ftsLimit, fileTypeFilter, fileTypeFilter, fileTypeFilter, fileTypeFilter, fileTypeFilter) as SearchDataItem[];
+    const runQuery = (query: string, fts: string, candidates?: number[]) =>
+      buildStatement(Boolean(candidates)).all({
+        query,
+        fts,
+        ftsLimit,
+        fileType: fileTypeFilter,
+        ...(candidates ? { candidates: JSON.stringify(candidates) } : {}),
+      }) as SearchDataItem[];
+    const allFiles = runQuery(q, ftsQuery, candidateIds);
+
+    // 原词命中过少时做拼写纠正（如 reprot -> report），纠正后的词走同一套评分，结果排在原词结果之后
+    // 纠正后的词不是原词的延伸，不能使用候选集合，改为按纠正后的词缓存结果
+    if (allFiles.length < FUZZY_FALLBACK_THRESHOLD) {
+      const corrected = correctSearchTerm(searchTerm);
+      if (corrected) {
+        const cacheKey = `${fileTypeFilter}\u0000${corrected}`;
+        let correctedAll = corrections?.get(cacheKey);
+        if (!correctedAll) {
+          correctedAll = runQuery(corrected.toLowerCase(), buildFtsQuery(corrected));
+          corrections?.set(cacheKey, correctedAll);
+        }
+        const seen = new Set(allFiles.map(item => item.id));
+        const correctedFiles = correctedAll
+          .filter(item => !seen.has(item.id))
+          .slice(0, 50 - allFiles.length);
+        allFiles.push(...correctedFiles);
+        logger.info(`拼写纠正: ${searchTerm} -> ${corrected}，补充 ${correctedFiles.length} 条结果`);
+      }
+    }
 
     // 统一日志输出到文件与终端
     logger.info(`搜索到的文件条数: ${allFiles.length}`);
@@ -184,9 +264,11 @@ export function searchPrograms(keyword: string, limit: number = 5): searchProgra
 
 /**
  * 快捷搜索
+ * @param candidateIds 文件候选 id（见 findFileCandidates），由输入会话在逐字输入时传入
+ * @param corrections 拼写纠正结果缓存，由输入会话传入
  * @returns 1、匹配的应用程序，2、普通文件
  */
-export function shortSearch(keyword: string, fileType?: string): shortSearchResult {
+export function shortSearch(keyword: string, fileType?: string, candidateIds?: number[], corrections?: CorrectionCache): shortSearchResult {
   if (!keyword) {
     return {
       data: [],
@@ -196,7 +278,7 @@ export function shortSearch(keyword: string, fileType?: string): shortSearchResu
   // 搜索应用程序
   const programs = searchPrograms(keyword);
   // 搜索拥有AI Mark的文件
-  const aiFiles = searchFiles(keyword, fileType, 50);
+  const aiFiles = searchFiles(keyword, fileType, 50, candidateIds, corrections);
 
   // console.log('搜索到的文件的第一个', aiFiles.data[0]);
   // 构造返回的data
@@ -0,0 +1,132 @@
+/**
+ * 快捷搜索的输入会话
+ * 每个窗口一个会话，逐字输入时：
+ * 1、缓存最近的查询结果（LRU），回删或切换分类时直接命中
+ * 2、新关键词包含上一个关键词时，只在上次的候选文件内缩小范围，不再全表扫描；
+ *    候选超过上限时（这次收集没有用上），关键词再多几个字符之前不再收集候选，直接全表搜索
+ * 3、原词命中过少时的拼写纠正结果按纠正后的词缓存，相邻按键纠正为同一个词时不再全表查询
+ * 4、丢弃已被更新按键取代、尚未开始执行的请求
+ */
+import type { WebContents } from 'electron';
+import type { CorrectionCache } from './search.js';
+import { findFileCandidates, shortSearch } from './search.js';
+
+// 每个会话缓存的查询结果数
+const RESULT_CACHE_SIZE = 32;
+// 每个会话缓存的拼写纠正结果数
+const CORRECTION_CACHE_SIZE = 8;
+// 候选文件上限，超过时不再缩小范围（传入的 id 过多反而比扫描更慢）
+const MAX_CANDIDATES = 20000;
+// 候选超过上限后，关键词在此基础上再多出这么多字符才重新收集候选（更长的词才可能足够少）
+const OVERFLOW_RETRY_CHARS = 3;
+// 超过该时间没有输入视为新的会话，避免缓存结果与库中新增文件长期不一致
+const SESSION_IDLE_MS = 5000;
+
+
+class SearchSession {
+    // 最近查询结果，Map 按插入顺序迭代，最早插入的即最久未使用
+    private results = new Map<string, shortSearchResult>();
+    // 拼写纠正结果（见 searchFiles），同样按插入顺序淘汰
+    private corrections: CorrectionCache = new Map();
+    // 上一个关键词（小写）及其名称/摘要/标签命中的文件 id
+    private candidates: { query: string; ids: number[] } | null = null;
+    // 最近一个候选超过上限的关键词（小写）
+    private overflowQuery: string | null = null;
+    private lastActive = 0;
+    // 每次按键递增，用于识别过期请求
+    public generation = 0;
+
+    /**
+     * 清空缓存与候选
+     */
+    reset() {
+        this.results.clear();
+        this.corrections.clear();
+        this.candidates = null;
+        this.overflowQuery = null;
+    }
+
+    /**
+     * 执行一次快捷搜索
+     */
+    search(keyword: string, fileType: string): shortSearchResult {
+        const now = Date.now();
+        if (!keyword || now - this.lastActive > SESSION_IDLE_MS) {
+            this.reset();
+        }
+        this.lastActive = now;
+        if (!keyword) {
+            return shortSearch(keyword, fileType);
+        }
+
+        // 1) 结果缓存
+        const key = `${fileType}\u0000${keyword}`;
+        const cached = this.results.get(key);
+        if (cached) {
+            this.results.delete(key);
+            this.results.set(key, cached);
+            return cached;
+        }
+
+        // 2) 关键词是上一个关键词的延伸时，在上次候选内缩小范围
+        const query = keyword.toLowerCase();
+        const overflowed = this.overflowQuery !== null && query.includes(this.overflowQuery)
+            && query.length < this.overflowQuery.length + OVERFLOW_RETRY_CHARS;
+        let ids: number[] | null = null;
+        if (!overflowed) {
+            const withinIds = this.candidates && query.includes(this.candidates.query) ? this.candidates.ids : null;
+            ids = findFileCandidates(keyword, withinIds, MAX_CANDIDATES);
+            this.overflowQuery = ids ? null : query;
+        }
+        this.candidates = ids ? { query, ids } : null;
+
+        const result = shortSearch(keyword, fileType, ids ?? undefined, this.corrections);
+        this.results.set(key, result);
+        if (this.results.size > RESULT_CACHE_SIZE) {
+            this.results.delete(this.results.keys().next().value);
+        }
+        if (this.corrections.size > CORRECTION_CACHE_SIZE) {
+            this.corrections.delete(this.corrections.keys().next().value);
+        }
+        return result;
+    }
+}
+
+
+const sessions = new Map<number, SearchSession>();
+
+
+/**
+ * 在发起窗口的输入会话中执行快捷搜索
+ * @param sender 发起搜索的窗口
+ * @returns 搜索结果；已被更新的按键取代时返回 stale: true 的空结果，前端应忽略
+ */
+export async function sessionShortSearch(sender: WebContents, keyword: string, fileType?: string): Promise<shortSearchResult> {
+    let session = sessions.get(sender.id);
+    if (!session) {
+        session = new SearchSession();
+        const id = sender.id;
+        sessions.set(id, session);
+        sender.once('destroyed', () => sessions.delete(id));
+    }
+
+    const generation = ++session.generation;
+    // 让出一次事件循环：上一个查询执行期间排队的新按键先登记，较旧的请求不再执行
+    await new Promise(resolve => setImmediate(resolve));
+    if (generation !== session.generation) {
+        return {
+            data: [],
+            total: 0,
+            stale: true,
+        };
+    }
+    return session.search(keyword, fileType || 'ALL');
+}
+
+
+/**
+ * 文件库发生变化时清空所有会话的缓存
+ */
+export function invalidateSearchSessions(): void {
+    sessions.forEach(session => session.reset());
+}
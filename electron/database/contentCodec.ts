@@ -0,0 +1,226 @@
+/**
+ * 文档正文压缩
+ * 基于原生模块 content_codec（zstd + 用语料训练的字典），向 SQLite 注册两个标量函数：
+ * zstd_compress(text)：写入 files.full_content 时使用，压缩后不更小则原样保留文本
+ * zstd_decompress(value)：BLOB 解压为文本，TEXT/NULL（未压缩的旧数据）原样返回；无法解压时报错中止语句
+ * zstd_dict_id(value)：BLOB 帧头中的字典 id（0 表示未使用字典），存量压缩时用于找出需要用字典重新压缩的正文
+ * 不依赖 electron（日志直接用 console），索引 Worker 的数据库连接中同样需要注册
+ */
+import * as fs from 'fs';
+import { createRequire } from 'module';
+import { Database } from 'better-sqlite3';
+import { createFilesFtsTriggers } from './schema.js';
+
+const require = createRequire(import.meta.url);
+
+// 压缩级别：兼顾入库速度与压缩率
+const COMPRESSION_LEVEL = 6;
+// 短于该字节数的正文不压缩，帧头开销抵消收益
+const MIN_COMPRESS_BYTES = 64;
+// 字典训练：字典大小、最少/最多样本数、单个样本截取的字符数、每次读取的样本数（读取间让出主线程）
+const DICT_SIZE = 112 * 1024;
+const DICT_MIN_SAMPLES = 200;
+const DICT_MAX_SAMPLES = 2000;
+const DICT_SAMPLE_CHARS = 16 * 1024;
+const DICT_READ_BATCH = 100;
+// 存量数据压缩的批大小：每批一个事务，在主线程上执行，需保持足够短
+const COMPACT_BATCH_SIZE = 100;
+// 查找无法解压的正文时每批读取的行数
+const REPAIR_BATCH_SIZE = 500;
+
+interface NativeContentCodec {
+  trainDictionary(samples: string[], dictSize: number): Promise<Buffer | null>;
+  loadDictionary(dict: Buffer, level: number): number;
+  compress(text: string, level?: number): Buffer | null;
+  decompress(data: Buffer): string | null;
+  dictId(data: Buffer): number;
+}
+
+let codec: NativeContentCodec | null = null;
+let loadFailed = false;
+let dictionaryLoaded = false; // 已有压缩字典，之后写入的正文都使用字典压缩
+
+
+/**
+ * 加载原生模块
+ * @returns 加载成功的原生模块实例，失败返回null
+ */
+function loadNativeModule(modulePath: string): NativeContentCodec | null {
+  if (codec || loadFailed) {
+    return codec;
+  }
+  try {
+    if (!fs.existsSync(modulePath)) {
+      throw new Error(`模块不存在: ${modulePath}`);
+    }
+    codec = require(modulePath);
+  } catch (error) {
+    loadFailed = true;
+    const msg = error instanceof Error ? error.message : '模块加载失败';
+    console.warn(`正文压缩模块不可用，full_content 将以明文存储: ${msg}`);
+  }
+  return codec;
+}
+
+
+/**
+ * 在数据库连接上注册 zstd_compress / zstd_decompress
+ * FTS 视图与触发器依赖这两个函数，每个连接打开后都必须先调用
+ * 原生模块不可用时两者退化为原样返回，新数据以明文存储
+ * @param modulePath content_codec.node 的路径
+ * @returns 原生模块是否可用
+ */
+export function registerContentFunctions(db: Database, modulePath: string): boolean {
+  const module = loadNativeModule(modulePath);
+
+  db.function('zstd_compress', (value: unknown) => {
+    if (typeof value !== 'string' || !codec) return value;
+    const rawBytes = Buffer.byteLength(value);
+    if (rawBytes < MIN_COMPRESS_BYTES) return value;
+    const packed = codec.compress(value, COMPRESSION_LEVEL);
+    return packed && packed.length < rawBytes ? packed : value;
+  });
+
+  // 不能声明为 deterministic：结果取决于已加载的字典
+  // 无法解压时必须报错：FTS 外部内容表的 'delete' 若拿到 NULL 会破坏索引，宁可中止语句
+  db.function('zstd_decompress', (value: unknown) => {
+    if (!Buffer.isBuffer(value)) return value;
+    if (!codec) {
+      throw new Error('full_content 解压失败：正文压缩模块不可用');
+    }
+    const text = codec.decompress(value);
+    if (text === null) {
+      throw new Error(`full_content 解压失败：字典 ${codec.dictId(value)} 未加载或数据损坏`);
+    }
+    return text;
+  });
+
+  db.function('zstd_dict_id', (value: unknown) => {
+    if (!Buffer.isBuffer(value) || !codec) return null;
+    return codec.dictId(value);
+  });
+
+  return module !== null;
+}
+
+
+/**
+ * 加载库中保存的全部字典，最近训练的一个用于之后的压缩
+ * @returns 加载的字典数
+ */
+export function loadContentDictionaries(db: Database): number {
+  if (!codec) return 0;
+  const dicts = db.prepare(`SELECT dict FROM content_dicts ORDER BY id`).pluck().all() as Buffer[];
+  let loaded = 0;
+  for (const dict of dicts) {
+    if (codec.loadDictionary(dict, COMPRESSION_LEVEL)) loaded++;
+  }
+  dictionaryLoaded = dictionaryLoaded || loaded > 0;
+  return loaded;
+}
+
+
+/**
+ * 从已有正文中随机抽样训练字典，保存并设为当前压缩字典
+ * 样本分批读取，训练在原生模块的后台线程进行，不阻塞主线程
+ * @returns 是否训练成功（样本不足时返回 false，待正文增多后再训练）
+ */
+export async function trainContentDictionary(db: Database): Promise<boolean> {
+  if (!codec) return false;
+
+  // 先随机取 id，再逐条读取，避免对全表正文解压后排序
+  const ids = db.prepare(`SELECT id FROM files WHERE full_content IS NOT NULL ORDER BY random() LIMIT ?`)
+    .pluck().all(DICT_MAX_SAMPLES) as number[];
+  if (ids.length < DICT_MIN_SAMPLES) return false;
+
+  const readSample = db.prepare(`SELECT substr(zstd_decompress(full_content), 1, ?) FROM files WHERE id = ?`).pluck();
+  const samples: string[] = [];
+  for (let i = 0; i < ids.length; i += DICT_READ_BATCH) {
+    for (const id of ids.slice(i, i + DICT_READ_BATCH)) {
+      const text = readSample.get(DICT_SAMPLE_CHARS, id) as string | null | undefined;
+      if (text) samples.push(text);
+    }
+    await new Promise(resolve => setImmediate(resolve));
+  }
+
+  const dict = await codec.trainDictionary(samples, DICT_SIZE);
+  if (!dict) return false;
+  const dictId = codec.loadDictionary(dict, COMPRESSION_LEVEL);
+  if (!dictId) return false;
+  dictionaryLoaded = true;
+
+  db.prepare(`INSERT OR IGNORE INTO content_dicts (dict_id, dict) VALUES (?, ?)`).run(dictId, dict);
+  console.log(`正文压缩字典训练完成: id=${dictId}, ${dict.length} 字节, ${samples.length} 个样本`);
+  return true;
+}
+
+
+/**
+ * 压缩一批存量正文：明文，以及有字典后仍是无字典压缩的正文（字典训练前写入的）
+ * 从 fromId 之后按 id 取一批，每批一个事务；压缩前后解压结果一致，更新触发器不会重建 FTS 索引
+ * @param fromId 上次处理到的 id
+ * @returns lastId 新的游标；compressed 本批重新压缩的行数；done 是否已处理到末尾
+ */
+export function compactContentBatch(db: Database, fromId: number): { lastId: number; compressed: number; done: boolean } {
+  if (!codec) return { lastId: fromId, compressed: 0, done: true };
+
+  const rows = db.prepare(`
+    SELECT id, (typeof(full_content) = 'text' OR (@recompress AND zstd_dict_id(full_content) = 0)) AS stale
+    FROM files WHERE id > @fromId ORDER BY id LIMIT @limit
+  `).all({ fromId, recompress: dictionaryLoaded ? 1 : 0, limit: COMPACT_BATCH_SIZE }) as { id: number; stale: number }[];
+  if (rows.length === 0) return { lastId: fromId, compressed: 0, done: true };
+
+  // 重新压缩时先解压：zstd_compress 只接收文本
+  const updateStmt = db.prepare(`
+    UPDATE files SET full_content = zstd_compress(zstd_decompress(full_content)) WHERE id = ? RETURNING typeof(full_content)
+  `).pluck();
+  const compressed = db.transaction(() => {
+    let count = 0;
+    for (const row of rows) {
+      if (row.stale && updateStmt.get(row.id) === 'blob') count++;
+    }
+    return count;
+  })();
+
+  return { lastId: rows[rows.length - 1].id, compressed, done: rows.length < COMPACT_BATCH_SIZE };
+}
+
+
+/**
+ * 修复无法解压的正文（数据损坏、字典丢失）
+ * zstd_decompress 遇到这些行会报错中止语句，删除/更新它们的操作会一直失败；
+ * 逐条记录日志后清空正文（之后重新提取），绕过 FTS 触发器清空，再 rebuild 重建 FTS 索引
+ * 原生模块不可用时所有压缩正文都无法解压，不做处理
+ * @returns 清空的行数
+ */
+export function repairUndecodableContent(db: Database): number {
+  if (!codec) return 0;
+
+  const selectBatch = db.prepare(`
+    SELECT id, path, full_content FROM files WHERE id > ? AND typeof(full_content) = 'blob' ORDER BY id LIMIT ?
+  `);
+  const broken: { id: number; path: string }[] = [];
+  let lastId = 0;
+  let rows: { id: number; path: string; full_content: Buffer }[];
+  do {
+    rows = selectBatch.all(lastId, REPAIR_BATCH_SIZE) as { id: number; path: string; full_content: Buffer }[];
+    for (const row of rows) {
+      if (codec.decompress(row.full_content) === null) {
+        console.error(`full_content 无法解压（字典 ${codec.dictId(row.full_content)}），清空后重新提取: id=${row.id}, ${row.path}`);
+        broken.push({ id: row.id, path: row.path });
+      }
+    }
+    if (rows.length > 0) lastId = rows[rows.length - 1].id;
+  } while (rows.length === REPAIR_BATCH_SIZE);
+  if (broken.length === 0) return 0;
+
+  // 触发器需要解压旧值，清空期间先删除；旧值无法解压，FTS 中残留的词只能靠 rebuild 清除
+  db.transaction(() => {
+    db.exec(`DROP TRIGGER IF EXISTS files_fts_au; DROP TRIGGER IF EXISTS files_fts_delete;`);
+    const clearStmt = db.prepare(`UPDATE files SET full_content = NULL, skip_ocr = NULL WHERE id = ?`);
+    for (const row of broken) clearStmt.run(row.id);
+    createFilesFtsTriggers(db);
+    db.exec(`INSERT INTO files_fts(files_fts) VALUES('rebuild');`);
+  })();
+  return broken.length;
+}
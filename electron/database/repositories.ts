@@ -15,7 +15,7 @@ const db = getDatabase()
  */
 export const checkTask = (filePath: string, type: 'ai' | 'ocr' | 'document') => {
     const checkStmt = db.prepare(`SELECT ai_mark,md5,path,size,modified_at,full_content,skip_ocr FROM files WHERE path = ?`);
-    const row = checkStmt.get(filePath) as { ai_mark: number, md5: string, path: string, size: number, modified_at: number, full_content: string, skip_ocr: number } | undefined;
+    const row = checkStmt.get(filePath) as { ai_mark: number, md5: string, path: string, size: number, modified_at: number, full_content: string | Buffer, skip_ocr: number } | undefined;
     const state = fs.statSync(filePath)
     // 检查文件是否存在
     if (!state) {
@@ -57,57 +57,98 @@ export const createProgramsDb = (db: Database) => {
 /**
  * 创建文件全文搜索FTS5虚拟表（影子表）
  * 用于倒排索引和全文内容搜索
+ * full_content 以 zstd 压缩存储，FTS 通过视图 files_content 读取解压后的正文（snippet() 同样经由该视图）
+ * 依赖 zstd_compress / zstd_decompress 函数，调用前需先 registerContentFunctions
  * @param db 
  */
 export const createFilesFtsDb = (db: Database) => {
     try {
-        // 1) 清理旧 FTS 与触发器，避免历史残留导致冲突（数据重建时使用）
-        // db.exec(`
-        // DROP TRIGGER IF EXISTS files_fts_ai;
-        // DROP TRIGGER IF EXISTS files_fts_au;
-        // DROP TRIGGER IF EXISTS files_fts_delete;
-        // DROP TABLE IF EXISTS files_fts;
-        // `);
-
-        // 2) 重建 FTS（修正 tokenize 写法，去掉 IF NOT EXISTS 以提升兼容）
+        // 1) 旧版 FTS 直接以 files 为内容表，压缩后会读到二进制数据，需要删除后重建
+        const existing = db.prepare(`SELECT sql FROM sqlite_master WHERE type = 'table' AND name = 'files_fts'`).pluck().get() as string | undefined;
+        const legacy = Boolean(existing) && !existing.includes('files_content');
+        if (legacy) {
+            db.exec(`
+            DROP TRIGGER IF EXISTS files_fts_ai;
+            DROP TRIGGER IF EXISTS files_fts_au;
+            DROP TRIGGER IF EXISTS files_fts_delete;
+            DROP TABLE IF EXISTS files_fts;
+            `);
+        }
+
+        // 2) 解压视图与 FTS（修正 tokenize 写法）
         db.exec(`
+        CREATE VIEW IF NOT EXISTS files_content AS
+          SELECT id, zstd_decompress(full_content) AS full_content FROM files;
         CREATE VIRTUAL TABLE IF NOT EXISTS files_fts USING fts5(
             full_content,
-            content=files,
+            content=files_content,
             content_rowid=id,
             tokenize='unicode61 remove_diacritics 2'
         );
         `);
 
-        // 3) 触发器采用 delete 哨兵 + insert 的推荐写法（不使用任何表别名）
-        db.exec(`
+        // 3) 触发器
+        createFilesFtsTriggers(db);
+
+        // 4) 仅在新建时回填（rebuild 经视图读取解压后的正文）；已有索引由触发器维护，不再重复写入
+        if (!existing || legacy) {
+            db.exec(`INSERT INTO files_fts(files_fts) VALUES('rebuild');`);
+        }
+    } catch (error) {
+        console.error('创建FTS表失败:', error);
+    }
+}
+
+
+/**
+ * 创建 FTS 同步触发器（delete 哨兵 + insert 的推荐写法，不使用任何表别名）
+ * 外部内容表删除索引时必须提供原正文，因此 delete 传入解压后的旧值
+ * 更新触发器只监听 full_content，且解压后的正文不变时（如存量正文重新压缩）不重建索引
+ * @param db 
+ */
+export const createFilesFtsTriggers = (db: Database) => {
+    // 早期版本的更新触发器没有 WHEN 条件，删除后重建
+    const updateTrigger = db.prepare(`SELECT sql FROM sqlite_master WHERE type = 'trigger' AND name = 'files_fts_au'`).pluck().get() as string | undefined;
+    if (updateTrigger && !updateTrigger.includes('WHEN')) {
+        db.exec(`DROP TRIGGER files_fts_au;`);
+    }
+
+    db.exec(`
         CREATE TRIGGER IF NOT EXISTS files_fts_ai AFTER INSERT ON files FOR EACH ROW BEGIN
           INSERT INTO files_fts(rowid, full_content)
-          VALUES (new.id, new.full_content);
+          VALUES (new.id, zstd_decompress(new.full_content));
         END;
         `);
 
-        db.exec(`
-        CREATE TRIGGER IF NOT EXISTS files_fts_au AFTER UPDATE ON files FOR EACH ROW BEGIN
-          INSERT INTO files_fts(files_fts, rowid) VALUES('delete', old.id);
-          INSERT INTO files_fts(rowid, full_content) VALUES (new.id, new.full_content);
+    db.exec(`
+        CREATE TRIGGER IF NOT EXISTS files_fts_au AFTER UPDATE OF full_content ON files FOR EACH ROW
+        WHEN zstd_decompress(old.full_content) IS NOT zstd_decompress(new.full_content) BEGIN
+          INSERT INTO files_fts(files_fts, rowid, full_content) VALUES('delete', old.id, zstd_decompress(old.full_content));
+          INSERT INTO files_fts(rowid, full_content) VALUES (new.id, zstd_decompress(new.full_content));
         END;
         `);
 
-        db.exec(`
+    db.exec(`
         CREATE TRIGGER IF NOT EXISTS files_fts_delete AFTER DELETE ON files FOR EACH ROW BEGIN
-          INSERT INTO files_fts(files_fts, rowid) VALUES('delete', old.id);
+          INSERT INTO files_fts(files_fts, rowid, full_content) VALUES('delete', old.id, zstd_decompress(old.full_content));
         END;
         `);
+}
 
-        // 4) 初始化回填，确保 FTS 与 files 同步，避免空索引或歧义（能够回填数据）
-        db.exec(`
-        INSERT INTO files_fts(rowid, full_content)
-        SELECT id, full_content FROM files WHERE full_content IS NOT NULL;
-        `);
-    } catch (error) {
-        console.error('创建FTS表失败:', error);
-    }
+
+/**
+ * 创建正文压缩字典表
+ * 每次训练新增一行；旧字典保留，用于解压用它压缩的数据
+ */
+export const createContentDictsDb = (db: Database) => {
+    db.exec(`
+            CREATE TABLE IF NOT EXISTS content_dicts (
+              id INTEGER PRIMARY KEY AUTOINCREMENT,
+              dict_id INTEGER NOT NULL UNIQUE,
+              dict BLOB NOT NULL,
+              created_at DATETIME DEFAULT CURRENT_TIMESTAMP
+            );
+          `)
 }
 
 
@@ -1,14 +1,21 @@
 import Database from 'better-sqlite3'
 import pathConfig from '../core/pathConfigs.js'
 import path from 'path'
+import { Worker } from 'worker_threads'
+import { fileURLToPath } from 'url'
 import { logger } from '../core/logger.js'
 import { ConfigName } from '../types/system.js'
 import { pinyin } from "pinyin-pro";
 import { extractIconOnWindows } from '../core/iconExtractor.js';
-import { createConfigDb, createFilesDb, createFilesFtsDb, createProgramsDb } from './schema.js'
+import { createConfigDb, createContentDictsDb, createFilesDb, createFilesFtsDb, createProgramsDb } from './schema.js'
+import { compactContentBatch, loadContentDictionaries, registerContentFunctions, repairUndecodableContent, trainContentDictionary } from './contentCodec.js'
 
 let db: Database.Database | null = null
 
+// 获取当前文件路径（ES模块兼容）
+const __filename = fileURLToPath(import.meta.url)
+const __dirname = path.dirname(__filename)
+
 
 /**
  * 初始化数据库并返回一个连接实例。
@@ -25,10 +32,15 @@ export function initializeDatabase(): Database.Database {
     logger.info(`数据库地址：${dbPath}`)
     db = new Database(dbPath) // verbose 用于在开发时打印SQL语句
 
+    // 只对新建的库生效（必须在建表前设置）；已有的库在存量正文压缩完成后由一次 VACUUM 切换，见 compressContent
+    db.pragma('auto_vacuum = INCREMENTAL')
     // 优化数据库性能
     db.pragma('journal_mode = WAL') // 提升并发写入性能
     // db.pragma('synchronous = NORMAL') // 在大多数情况下是安全且高效的
 
+    // 注册正文压缩函数（FTS 视图与触发器依赖，必须先于建表）
+    registerContentFunctions(db, pathConfig.get('contentCodec'))
+
     //创建表
     try {
       createFilesDb(db)
@@ -45,6 +57,17 @@ export function initializeDatabase(): Database.Database {
     } catch (error) {
       logger.error(`创建表失败3: ${JSON.stringify(error)}`)
     }
+    try {
+      createContentDictsDb(db)
+    } catch (error) {
+      logger.error(`创建表失败4: ${JSON.stringify(error)}`)
+    }
+    // 加载压缩字典：用字典压缩的正文解压时需要，必须先于任何读取正文的操作
+    try {
+      loadContentDictionaries(db)
+    } catch (error) {
+      logger.error(`加载正文压缩字典失败: ${error}`)
+    }
     try {
       createFilesFtsDb(db)
     } catch (error) {
@@ -65,6 +88,11 @@ export function initializeDatabase(): Database.Database {
     insertConfig.run('last_index_file_count', '0', 'number', '上次索引的文件数量')
     insertConfig.run('ignored_folders', '[]', 'json', '忽略索引的文件夹列表')
     insertConfig.run('ignore_hidden_files', 'false', 'boolean', '是否忽略隐藏文件')
+    insertConfig.run('content_compact_id', '0', 'number', '存量正文已压缩到的文件id')
+    insertConfig.run('content_vacuumed', 'false', 'boolean', '存量正文压缩后是否已整库 VACUUM')
+
+    // 后台压缩存量正文，不阻塞启动
+    setImmediate(() => void compressContent())
 
     return db
   } catch (error) {
@@ -73,6 +101,86 @@ export function initializeDatabase(): Database.Database {
   }
 }
 
+/**
+ * 正文压缩后台任务：还没有字典时先用现有正文训练，再分批压缩存量正文
+ * 每批结束后保存游标并让出事件循环，中途退出时下次启动从游标继续
+ * 全部完成后整库 VACUUM 一次（只做一次，记录在 content_vacuumed）：已有的库只有 VACUUM 后文件才会变小，
+ * 并由此切换为增量回收，之后每批释放的页由 incremental_vacuum 归还
+ */
+const compressContent = async () => {
+  try {
+    if (db.prepare(`SELECT COUNT(*) FROM content_dicts`).pluck().get() === 0 && await trainContentDictionary(db)) {
+      // 有了新字典，训练前无字典压缩的正文也需要重新压缩，从头开始
+      setConfig('content_compact_id', 0, 'number')
+    }
+
+    let cursor = getConfig('content_compact_id') ?? 0
+    let total = 0
+    let repaired = false
+    while (true) {
+      let batch: ReturnType<typeof compactContentBatch>
+      try {
+        batch = compactContentBatch(db, cursor)
+      } catch (error) {
+        // 本批有无法解压的正文：修复后重试一次，仍失败则放弃本次压缩
+        if (repaired || repairUndecodableContent(db) === 0) throw error
+        repaired = true
+        continue
+      }
+      const { lastId, compressed, done } = batch
+      cursor = lastId
+      total += compressed
+      setConfig('content_compact_id', cursor, 'number')
+      if (compressed > 0) {
+        db.pragma('incremental_vacuum')
+      }
+      if (done) break
+      await new Promise(resolve => setImmediate(resolve))
+    }
+    if (total > 0) {
+      logger.info(`已压缩 ${total} 条存量正文`)
+    }
+
+    if (!getConfig('content_vacuumed')) {
+      // 等首次索引完成再做，避免与批量写入争用写锁
+      const { waitForIndexUpdate } = await import('../core/appState.js')
+      await waitForIndexUpdate()
+      const startTime = Date.now()
+      await vacuumDatabase(db.name)
+      setConfig('content_vacuumed', true, 'boolean')
+      logger.info(`数据库 VACUUM 完成，耗时 ${Date.now() - startTime} 毫秒`)
+    }
+  } catch (error) {
+    logger.error(`正文压缩失败: ${error}`)
+  }
+}
+
+/**
+ * 在 Worker 的独立连接上整库 VACUUM 并切换为增量回收，不阻塞主线程
+ * VACUUM 期间主线程的读取不受影响，写入会等待写锁
+ * @param dbPath 数据库文件路径
+ */
+const vacuumDatabase = (dbPath: string) => {
+  return new Promise<void>((resolve, reject) => {
+    const worker = new Worker(path.join(__dirname, '../workers/vacuum.worker.js'), {
+      workerData: { dbPath }
+    })
+    worker.once('message', (message) => {
+      if (message.status === 'success') {
+        resolve()
+      } else {
+        reject(new Error(message.error))
+      }
+    })
+    worker.once('error', reject)
+    worker.once('exit', (code) => {
+      if (code !== 0) {
+        reject(new Error(`VACUUM Worker 异常退出，退出码: ${code}`))
+      }
+    })
+  })
+}
+
 /**
  * 添加新字段
  */
@@ -0,0 +1,211 @@
+/**
+ * 正文压缩基准测试
+ * 对比明文存储（旧 schema）与 zstd 字典压缩存储（新 schema）的：入库吞吐、数据库体积、搜索吞吐
+ * 搜索使用与 electron/core/search.ts searchFiles 相同的查询（含 snippet），修改那边的查询时同步修改这里
+ *
+ * 用法（先 npm run build 编译原生模块）：
+ *   node bench/content_codec.bench.mjs [已有的 metaData.db 路径 | 文本文件目录]
+ * 传入已有数据库时使用其中的 full_content 作为语料，传入目录时使用其中的文本文件，否则生成合成语料
+ */
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { createRequire } from 'module';
+import { fileURLToPath } from 'url';
+
+const __dirname = path.dirname(fileURLToPath(import.meta.url));
+const require = createRequire(path.join(__dirname, '..', '..', '..', 'package.json'));
+const Database = require('better-sqlite3');
+const codec = require(path.join(__dirname, '..', 'build', 'Release', 'content_codec.node'));
+
+const LEVEL = 6;
+const SEARCH_QUERIES = 2000;
+
+const TEXT_EXTS = new Set(['.txt', '.md', '.csv', '.json', '.html', '.xml', '.log']);
+const MAX_DOCS = 20000;
+
+// 解压已有数据库中的正文：无法解压时报错，不静默丢弃
+function decompressOrThrow(value) {
+  if (!Buffer.isBuffer(value)) return value;
+  const text = codec.decompress(value);
+  if (text === null) throw new Error(`无法解压 full_content（字典 ${codec.dictId(value)} 未加载或数据损坏）`);
+  return text;
+}
+
+// 语料：已有数据库中的正文、目录中的文本文件，或合成的中英文混合文本
+function loadCorpus(source) {
+  if (source && fs.statSync(source).isDirectory()) {
+    const docs = [];
+    const walk = dir => {
+      for (const entry of fs.readdirSync(dir, { withFileTypes: true })) {
+        if (docs.length >= MAX_DOCS) return;
+        const file = path.join(dir, entry.name);
+        if (entry.isDirectory()) walk(file);
+        else if (TEXT_EXTS.has(path.extname(entry.name).toLowerCase())) docs.push(fs.readFileSync(file, 'utf8'));
+      }
+    };
+    walk(source);
+    return docs.filter(Boolean);
+  }
+  if (source) {
+    const db = new Database(source, { readonly: true });
+    // 先加载库中的字典，否则用字典压缩的正文无法解压
+    const hasDicts = db.prepare(`SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'content_dicts'`).get();
+    if (hasDicts) {
+      for (const dict of db.prepare(`SELECT dict FROM content_dicts ORDER BY id`).pluck().all()) {
+        codec.loadDictionary(dict, LEVEL);
+      }
+    }
+    db.function('zstd_decompress', decompressOrThrow);
+    const rows = db.prepare(`SELECT zstd_decompress(full_content) FROM files WHERE full_content IS NOT NULL`).pluck().all();
+    db.close();
+    return rows.filter(Boolean);
+  }
+  const words = ['季度', '报告', '销售', '客户', '合同', '会议纪要', 'revenue', 'quarterly', 'project', 'invoice', 'meeting', 'summary', 'total', 'amount'];
+  const docs = [];
+  for (let i = 0; i < 20000; i++) {
+    const length = 80 + ((i * 7919) % 900);
+    const parts = [`文档 ${i} 标题`];
+    for (let k = 0; k < length; k++) parts.push(words[(i * 31 + k * 17 + (k >> 3)) % words.length]);
+    docs.push(parts.join(' '));
+  }
+  return docs;
+}
+
+// mode: plain 明文，zstd 不使用字典压缩，zstd+dict 使用字典压缩
+function createDb(file, mode) {
+  const db = new Database(file);
+  db.pragma('journal_mode = WAL');
+  db.function('zstd_compress', v => {
+    if (mode === 'plain' || typeof v !== 'string' || Buffer.byteLength(v) < 64) return v;
+    const packed = codec.compress(v, LEVEL, mode === 'zstd+dict');
+    return packed && packed.length < Buffer.byteLength(v) ? packed : v;
+  });
+  db.function('zstd_decompress', decompressOrThrow);
+  const content = mode === 'plain' ? 'files' : 'files_content';
+  db.exec(`
+    CREATE TABLE files (
+      id INTEGER PRIMARY KEY AUTOINCREMENT, md5 TEXT, path TEXT, name TEXT NOT NULL, ext TEXT, size INTEGER,
+      created_at DATETIME, modified_at DATETIME, summary TEXT, full_content TEXT, skip_ocr INTEGER, ai_mark INTEGER,
+      last_access_time DATETIME, click_count INTEGER, tags TEXT DEFAULT '[]'
+    );
+    CREATE VIEW files_content AS SELECT id, zstd_decompress(full_content) AS full_content FROM files;
+    CREATE VIRTUAL TABLE files_fts USING fts5(full_content, content=${content}, content_rowid=id, tokenize='unicode61 remove_diacritics 2');
+    CREATE TRIGGER files_fts_ai AFTER INSERT ON files FOR EACH ROW BEGIN
+      INSERT INTO files_fts(rowid, full_content) VALUES (new.id, zstd_decompress(new.full_content));
+    END;
+  `);
+  return db;
+}
+
+// 外部语料的查询词：取前 200 篇中出现次数排第 200~204 的词，高频词几乎命中全部文档，不像真实搜索（合成语料用固定词）
+function pickTerms(corpus) {
+  const counts = new Map();
+  for (const doc of corpus.slice(0, 200)) {
+    for (const [word] of doc.toLowerCase().matchAll(/[\p{L}\p{N}]{4,}/gu)) counts.set(word, (counts.get(word) ?? 0) + 1);
+  }
+  return [...counts.entries()].sort((a, b) => b[1] - a[1]).slice(200, 205).map(([word]) => word);
+}
+
+// searchFiles 的查询（不限定候选集合、不按分类过滤）
+const SEARCH_SQL = `
+  WITH q(query) AS (SELECT lower(@query)),
+  ftsHits AS (
+    SELECT rowid, bm25(files_fts) AS fts_score
+    FROM files_fts WHERE files_fts MATCH @fts ORDER BY bm25(files_fts) LIMIT @ftsLimit
+  ),
+  ranked AS (
+    SELECT
+      f.id, f.path, f.name, f.modified_at, f.last_access_time, f.ext, f.summary, f.ai_mark, f.click_count,
+      (
+        0.35 * CASE WHEN lower(f.name) LIKE q.query || '%' THEN CAST(length(q.query) AS REAL) / NULLIF(length(f.name),0) ELSE 0 END
+      + 0.25 * CASE WHEN instr(lower(f.name),q.query) > 0 THEN 1 - (instr(lower(f.name),q.query) - 1) / CAST(length(f.name) AS REAL) ELSE 0 END
+      + 0.18 * COALESCE(1.0 / (ftsHits.fts_score + 1.0), 0.0)
+      + 0.10 * (1.0 - 1.0 / (COALESCE(f.click_count,0) + 1))
+      + 0.06 * (
+          CASE
+            WHEN f.last_access_time IS NULL THEN 0
+            ELSE
+              CASE
+                WHEN (julianday('now') - julianday(f.last_access_time)) <= 0.5 THEN 1.0
+                WHEN (julianday('now') - julianday(f.last_access_time)) >= 90.0 THEN 0.0
+                ELSE 1.0 - ((julianday('now') - julianday(f.last_access_time)) - 0.5) / (90.0 - 0.5)
+              END
+          END
+        )
+      + 0.04 * (1.0 - MIN(length(f.name), 255) / 255.0)
+      ) AS score,
+      ftsHits.rowid AS fts_rowid
+    FROM files f
+    LEFT JOIN ftsHits ON ftsHits.rowid = f.id
+    CROSS JOIN q
+    WHERE (
+      lower(f.name) LIKE '%' || @query || '%'
+      OR lower(f.summary) LIKE '%' || @query || '%'
+      OR lower(f.tags) LIKE '%' || @query || '%'
+      OR ftsHits.rowid IS NOT NULL
+    )
+    ORDER BY f.ai_mark DESC, score DESC, f.name
+    LIMIT 50
+  )
+  SELECT
+    ranked.id, ranked.path, ranked.name, ranked.modified_at, ranked.last_access_time, ranked.ext, ranked.summary, ranked.ai_mark, ranked.click_count, ranked.score,
+    CASE WHEN ranked.fts_rowid IS NOT NULL THEN (
+      SELECT snippet(files_fts, 0, '<mark>', '</mark>', '...', 16) FROM files_fts
+      WHERE files_fts MATCH @fts AND rowid = ranked.fts_rowid
+    ) END AS snippet
+  FROM ranked
+  ORDER BY ranked.ai_mark DESC, ranked.score DESC, ranked.name
+`;
+
+function fileSize(file) {
+  return ['', '-wal'].reduce((sum, suffix) => sum + (fs.existsSync(file + suffix) ? fs.statSync(file + suffix).size : 0), 0);
+}
+
+function run(label, corpus, terms, dir) {
+  const file = path.join(dir, `${label}.db`);
+  const db = createDb(file, label);
+
+  const insert = db.prepare(`INSERT INTO files (md5, path, name, ext, full_content) VALUES (?, ?, ?, '.txt', zstd_compress(?))`);
+  const insertAll = db.transaction(docs => docs.forEach((doc, i) => insert.run(`md5-${i}`, `/bench/doc${i}.txt`, `doc${i}.txt`, doc)));
+  let start = process.hrtime.bigint();
+  insertAll(corpus);
+  const insertMs = Number(process.hrtime.bigint() - start) / 1e6;
+  db.pragma('wal_checkpoint(TRUNCATE)');
+
+  const search = db.prepare(SEARCH_SQL);
+  start = process.hrtime.bigint();
+  for (let i = 0; i < SEARCH_QUERIES; i++) {
+    const term = terms[i % terms.length];
+    search.all({ query: term, fts: `${term}*`, ftsLimit: 200 });
+  }
+  const searchMs = Number(process.hrtime.bigint() - start) / 1e6;
+
+  db.close();
+  return {
+    label,
+    'insert docs/s': Math.round(corpus.length / (insertMs / 1000)),
+    'db size (MB)': (fileSize(file) / 1024 / 1024).toFixed(1),
+    'search queries/s': Math.round(SEARCH_QUERIES / (searchMs / 1000)),
+  };
+}
+
+const corpus = loadCorpus(process.argv[2]);
+const terms = process.argv[2] ? pickTerms(corpus) : ['报告', 'quarterly', '客户', 'invoice', 'meeting'];
+const rawMb = corpus.reduce((sum, doc) => sum + Buffer.byteLength(doc), 0) / 1024 / 1024;
+console.log(`语料: ${corpus.length} 篇, ${rawMb.toFixed(1)} MB, 查询词: ${terms.join(', ')}`);
+
+const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'osai-codec-bench-'));
+try {
+  const results = [run('plain', corpus, terms, dir), run('zstd', corpus, terms, dir)];
+  // 用语料样本训练字典后压缩（与应用中的训练参数一致）
+  const dict = await codec.trainDictionary(corpus.slice(0, 2000).map(doc => doc.slice(0, 16 * 1024)), 112 * 1024);
+  if (dict && codec.loadDictionary(dict, LEVEL)) {
+    results.push(run('zstd+dict', corpus, terms, dir));
+  } else {
+    console.log('样本不足，跳过字典压缩');
+  }
+  console.table(results);
+} finally {
+  fs.rmSync(dir, { recursive: true, force: true });
+}
@@ -21,6 +21,76 @@
           "AdditionalOptions": ["/utf-8"]
         }
       }
+    },
+    {
+      "target_name": "fuzzy_search",
+      "sources": [
+        "src/fuzzy_index.cpp",
+        "src/fuzzy_binding.cpp",
+      ],
+      "include_dirs": [
+        "<!@(node -p \"require('node-addon-api').include\")"
+      ],
+      "defines": [
+        "NAPI_DISABLE_CPP_EXCEPTIONS"
+      ],
+      "cflags_cc": ["-std=c++17", "-O3"],
+      "xcode_settings": {
+        "CLANG_CXX_LANGUAGE_STANDARD": "c++17",
+        "GCC_OPTIMIZATION_LEVEL": "3"
+      },
+      "msvs_settings": {
+        "VCCLCompilerTool": {
+          "AdditionalOptions": ["/utf-8", "/std:c++17", "/O2"]
+        }
+      }
     }
+  ],
+  # content_codec 依赖 zstd，找不到时跳过该目标，不影响其余模块编译（运行时正文以明文存储）
+  # Windows 需设置 ZSTD_ROOT 指向 zstd 的安装目录（如 vcpkg 的 installed/x64-windows-static），其余平台通过 pkg-config 查找
+  "variables": {
+    "zstd_available": "<!(node -p \"process.platform === 'win32' ? +require('fs').existsSync((process.env.ZSTD_ROOT || '') + '/include/zstd.h') : +(require('child_process').spawnSync('pkg-config', ['--exists', 'libzstd']).status === 0)\")"
+  },
+  "conditions": [
+    ["zstd_available==1", {
+      "targets": [
+        {
+          "target_name": "content_codec",
+          "sources": [
+            "src/content_codec.cpp",
+            "src/content_codec_binding.cpp",
+          ],
+          "include_dirs": [
+            "<!@(node -p \"require('node-addon-api').include\")"
+          ],
+          "defines": [
+            "NAPI_DISABLE_CPP_EXCEPTIONS"
+          ],
+          "cflags_cc": ["-std=c++17", "-O3"],
+          "xcode_settings": {
+            "CLANG_CXX_LANGUAGE_STANDARD": "c++17",
+            "GCC_OPTIMIZATION_LEVEL": "3"
+          },
+          "msvs_settings": {
+            "VCCLCompilerTool": {
+              "AdditionalOptions": ["/utf-8", "/std:c++17", "/O2"]
+            }
+          },
+          "conditions": [
+            # Windows 需要设置 ZSTD_ROOT 指向 zstd 的安装目录（如 vcpkg 的 installed/x64-windows-static）
+            ["OS=='win'", {
+              "include_dirs": ["<!(node -p \"process.env.ZSTD_ROOT || ''\")/include"],
+              "libraries": ["<!(node -p \"process.env.ZSTD_ROOT || ''\")/lib/zstd.lib"]
+            }, {
+              "cflags_cc": ["<!@(pkg-config --cflags libzstd)"],
+              "xcode_settings": {
+                "OTHER_CPLUSPLUSFLAGS": ["<!@(pkg-config --cflags libzstd)"]
+              },
+              "libraries": ["<!@(pkg-config --libs libzstd)"]
+            }]
+          ]
+        }
+      ]
+    }]
   ]
-}
\ No newline at end of file
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * 文档正文压缩编解码
+ * 基于 zstd，支持用语料训练的字典压缩（短文本压缩率显著提升）
+ * 可在多个线程（Worker）中同时使用：压缩/解压上下文按线程独立，字典注册表加锁
+ */
+class ContentCodec {
+public:
+    /**
+     * 用样本训练字典
+     * @param samples 样本文本
+     * @param dictSize 字典最大字节数
+     * @return 字典内容，样本不足等原因训练失败时返回空数组
+     */
+    static std::vector<uint8_t> TrainDictionary(const std::vector<std::string>& samples, size_t dictSize);
+
+    /**
+     * 加载字典：注册用于解压，并设为之后压缩使用的字典
+     * @param dict 字典内容
+     * @param level 使用该字典压缩时的压缩级别
+     * @return 字典 id（写入每个压缩帧的帧头），失败返回 0
+     */
+    static uint32_t LoadDictionary(const uint8_t* dict, size_t size, int level);
+
+    /**
+     * 压缩，有已加载的字典时使用最近加载的字典
+     * 帧中写入内容校验和，解压时校验，数据损坏时 Decompress 失败而不是返回错误的文本
+     * @param level 不使用字典时的压缩级别
+     * @param useDictionary 为 false 时即使已加载字典也不使用（基准测试对比用）
+     * @return 是否成功
+     */
+    static bool Compress(const char* src, size_t size, int level, std::vector<uint8_t>& out, bool useDictionary = true);
+
+    /**
+     * 解压单个 zstd 帧，按帧头中的字典 id 选择字典
+     * @return 是否成功（不是 zstd 帧、字典未加载、数据损坏时失败）
+     */
+    static bool Decompress(const uint8_t* src, size_t size, std::string& out);
+
+    /**
+     * 读取帧头中的字典 id
+     * @return 字典 id，未使用字典或不是 zstd 帧时返回 0
+     */
+    static uint32_t FrameDictId(const uint8_t* src, size_t size);
+};
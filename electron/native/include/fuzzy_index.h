@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * 文件名模糊匹配索引
+ * 从文件名中提取去重后的词典，使用 SymSpell 删除索引生成候选词，
+ * 再用 Hyyrö 位并行 OSA 距离（相邻字符交换计 1 次编辑）校验，实现拼写容错（如 reprot -> report）
+ *
+ * 构建分两步：AddNames 可分批多次调用，Finish 生成删除索引，之后只读
+ */
+class FuzzyIndex {
+public:
+    /**
+     * 单个纠错候选
+     */
+    struct Suggestion {
+        std::string term;   // 词典中的词（UTF-8，已转小写）
+        int distance;       // 与查询词的编辑距离
+        uint32_t count;     // 该词在文件名中出现的次数
+    };
+
+    /**
+     * 位并行编辑距离的模式预处理，只取决于查询词，一次查询内复用
+     * 每个字符对应一个位掩码，第 i 位表示模式第 i 个字符等于该字符
+     */
+    struct BitPattern {
+        uint64_t ascii[128] = {};
+        std::vector<std::pair<char32_t, uint64_t>> other;
+
+        BitPattern(const char32_t* p, size_t m);
+        uint64_t Eq(char32_t c) const;
+    };
+
+    // 支持的最大编辑距离
+    static constexpr int kMaxDistance = 2;
+    // SymSpell 前缀长度，只对前缀生成删除变体以控制索引体积
+    static constexpr size_t kPrefixLength = 7;
+    // 参与索引的最短/最长词长（按码点计），超过 64 无法用单个机器字做位并行
+    static constexpr size_t kMinTermLength = 3;
+    static constexpr size_t kMaxTermLength = 64;
+
+    /**
+     * 切词并加入词典，可分批调用
+     * @param names 以 '\n' 分隔的文件名（UTF-8）
+     */
+    void AddNames(const std::string& names);
+
+    /**
+     * 释放去重用的哈希表，生成删除索引
+     */
+    void Finish();
+
+    /**
+     * 查询与 term 编辑距离不超过 maxDistance 的词
+     * @param term 查询词（UTF-8）
+     * @param maxDistance 最大编辑距离，会被限制在 kMaxDistance 以内
+     * @param limit 最多返回的候选数
+     * @return 按距离升序、出现次数降序排列的候选
+     */
+    std::vector<Suggestion> Suggest(const std::string& term, int maxDistance, size_t limit) const;
+
+    /**
+     * 词典中是否有以 prefix 开头的词（含 prefix 本身），逐字输入时未输完的词不应被当作错拼
+     * @param prefix 查询词（UTF-8）
+     */
+    bool HasPrefix(const std::string& prefix) const;
+
+    /**
+     * 词典中去重后的词数
+     */
+    size_t TermCount() const { return counts_.size(); }
+
+    /**
+     * 将文件名切分为小写词（码点序列）
+     */
+    static void Tokenize(const std::string& text, std::vector<std::u32string>& out);
+
+    /**
+     * 计算 a、b 的 OSA 距离（插入、删除、替换、相邻交换各计 1），超过 maxDistance 时提前返回 maxDistance + 1
+     * a 的长度不能超过 64
+     */
+    static int BoundedDistance(const char32_t* a, size_t m, const char32_t* b, size_t n, int maxDistance);
+
+    /**
+     * 同上，使用预处理好的模式（a 的长度为 m）
+     */
+    static int BoundedDistance(const BitPattern& pattern, size_t m, const char32_t* b, size_t n, int maxDistance);
+
+private:
+    // 词典：所有词的码点连续存放，词 id 的码点位于 chars_[termOffsets_[id], termOffsets_[id + 1])
+    std::vector<char32_t> chars_;
+    std::vector<uint32_t> termOffsets_{0};
+    std::vector<uint32_t> counts_;
+    // 构建期间去重用的开放寻址哈希表（槽位存词 id + 1）及每个词的哈希，Finish 后释放
+    std::vector<uint32_t> slots_;
+    std::vector<uint32_t> termHashes_;
+    // 删除变体哈希桶 -> 词 id（CSR 布局）：桶 b 的词 id 位于 bucketIds_[bucketOffsets_[b], bucketOffsets_[b + 1])
+    // 同桶内的哈希冲突只会带来多余候选，由编辑距离校验过滤
+    std::vector<uint32_t> bucketOffsets_;
+    std::vector<uint32_t> bucketIds_;
+    uint32_t bucketMask_ = 0;
+    // 按码点字典序排列的词 id，用于前缀查询
+    std::vector<uint32_t> sortedIds_;
+
+    const char32_t* TermData(uint32_t id) const { return chars_.data() + termOffsets_[id]; }
+    size_t TermLength(uint32_t id) const { return termOffsets_[id + 1] - termOffsets_[id]; }
+    void AddTerm(const std::u32string& term);
+    void GrowSlots();
+
+    static uint32_t Hash(const char32_t* s, size_t n, size_t skip1 = SIZE_MAX, size_t skip2 = SIZE_MAX);
+    static void CollectDeletes(const char32_t* key, size_t n, int maxDistance, std::vector<uint32_t>& hashes);
+};
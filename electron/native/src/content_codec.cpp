@@ -0,0 +1,140 @@
+// 文档正文 zstd 编解码
+#include "../include/content_codec.h"
+
+#include <zstd.h>
+#include <zdict.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+// 单个文档解压后的上限，防止损坏的帧头申请过大内存
+constexpr unsigned long long kMaxContentSize = 256ull * 1024 * 1024;
+
+struct CCtxDeleter { void operator()(ZSTD_CCtx* p) const { ZSTD_freeCCtx(p); } };
+struct DCtxDeleter { void operator()(ZSTD_DCtx* p) const { ZSTD_freeDCtx(p); } };
+struct CDictDeleter { void operator()(ZSTD_CDict* p) const { ZSTD_freeCDict(p); } };
+struct DDictDeleter { void operator()(ZSTD_DDict* p) const { ZSTD_freeDDict(p); } };
+
+// 已加载的字典：解压按 id 查找，压缩使用最近加载的一个
+struct DictionaryRegistry {
+    std::mutex mutex;
+    std::unordered_map<uint32_t, std::shared_ptr<ZSTD_DDict>> ddicts;
+    std::shared_ptr<ZSTD_CDict> cdict;
+};
+
+DictionaryRegistry& Registry() {
+    static DictionaryRegistry registry;
+    return registry;
+}
+
+// 每个线程复用自己的上下文，避免每次压缩都重新分配
+ZSTD_CCtx* ThreadCCtx() {
+    thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> cctx(ZSTD_createCCtx());
+    return cctx.get();
+}
+
+ZSTD_DCtx* ThreadDCtx() {
+    thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> dctx(ZSTD_createDCtx());
+    return dctx.get();
+}
+
+} // namespace
+
+
+std::vector<uint8_t> ContentCodec::TrainDictionary(const std::vector<std::string>& samples, size_t dictSize) {
+    std::string buffer;
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        if (sample.empty()) continue;
+        buffer += sample;
+        sizes.push_back(sample.size());
+    }
+
+    if (sizes.empty() || dictSize == 0) return {};
+    std::vector<uint8_t> dict(dictSize);
+    size_t result = ZDICT_trainFromBuffer(dict.data(), dict.size(), buffer.data(), sizes.data(), static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(result)) return {};
+    dict.resize(result);
+    return dict;
+}
+
+
+uint32_t ContentCodec::LoadDictionary(const uint8_t* dict, size_t size, int level) {
+    uint32_t dictId = ZSTD_getDictID_fromDict(dict, size);
+    if (dictId == 0) return 0;
+
+    std::shared_ptr<ZSTD_CDict> cdict(ZSTD_createCDict(dict, size, level), CDictDeleter());
+    std::shared_ptr<ZSTD_DDict> ddict(ZSTD_createDDict(dict, size), DDictDeleter());
+    if (!cdict || !ddict) return 0;
+
+    DictionaryRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.ddicts[dictId] = std::move(ddict);
+    registry.cdict = std::move(cdict);
+    return dictId;
+}
+
+
+bool ContentCodec::Compress(const char* src, size_t size, int level, std::vector<uint8_t>& out, bool useDictionary) {
+    std::shared_ptr<ZSTD_CDict> cdict;
+    if (useDictionary) {
+        DictionaryRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        cdict = registry.cdict;
+    }
+
+    ZSTD_CCtx* cctx = ThreadCCtx();
+    if (!cctx) return false;
+    // 每次重置参数：上次引用的字典可能已被替换释放
+    // 写入内容校验和：损坏的帧大多仍能解出（错误的）文本，只有校验和能让解压可靠地失败
+    ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
+    size_t status = ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1);
+    if (!ZSTD_isError(status)) {
+        status = cdict
+            ? ZSTD_CCtx_refCDict(cctx, cdict.get())
+            : ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+    }
+    if (ZSTD_isError(status)) return false;
+
+    out.resize(ZSTD_compressBound(size));
+    size_t written = ZSTD_compress2(cctx, out.data(), out.size(), src, size);
+    if (ZSTD_isError(written)) return false;
+    out.resize(written);
+    return true;
+}
+
+
+bool ContentCodec::Decompress(const uint8_t* src, size_t size, std::string& out) {
+    unsigned long long contentSize = ZSTD_getFrameContentSize(src, size);
+    if (contentSize == ZSTD_CONTENTSIZE_ERROR || contentSize == ZSTD_CONTENTSIZE_UNKNOWN || contentSize > kMaxContentSize) {
+        return false;
+    }
+
+    std::shared_ptr<ZSTD_DDict> ddict;
+    uint32_t dictId = ZSTD_getDictID_fromFrame(src, size);
+    if (dictId != 0) {
+        DictionaryRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.ddicts.find(dictId);
+        if (it == registry.ddicts.end()) return false;
+        ddict = it->second;
+    }
+
+    ZSTD_DCtx* dctx = ThreadDCtx();
+    if (!dctx) return false;
+    out.resize(static_cast<size_t>(contentSize));
+    size_t written = ddict
+        ? ZSTD_decompress_usingDDict(dctx, &out[0], out.size(), src, size, ddict.get())
+        : ZSTD_decompressDCtx(dctx, &out[0], out.size(), src, size);
+    if (ZSTD_isError(written) || written != out.size()) return false;
+    return true;
+}
+
+
+uint32_t ContentCodec::FrameDictId(const uint8_t* src, size_t size) {
+    return ZSTD_getDictID_fromFrame(src, size);
+}
@@ -0,0 +1,166 @@
+#include <napi.h>
+#include "../include/content_codec.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * 后台训练字典：上千个样本的训练耗时可达数秒，不能在主线程进行
+ */
+class TrainDictionaryWorker : public Napi::AsyncWorker {
+public:
+    TrainDictionaryWorker(Napi::Env env, std::vector<std::string> samples, size_t dictSize)
+        : Napi::AsyncWorker(env), samples_(std::move(samples)), dictSize_(dictSize),
+          deferred_(Napi::Promise::Deferred::New(env)) {}
+
+    Napi::Promise Promise() { return deferred_.Promise(); }
+
+    void Execute() override {
+        dict_ = ContentCodec::TrainDictionary(samples_, dictSize_);
+        samples_.clear();
+        samples_.shrink_to_fit();
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (dict_.empty()) {
+            deferred_.Resolve(env.Null());
+            return;
+        }
+        deferred_.Resolve(Napi::Buffer<uint8_t>::Copy(env, dict_.data(), dict_.size()));
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    std::vector<std::string> samples_;
+    size_t dictSize_;
+    std::vector<uint8_t> dict_;
+    Napi::Promise::Deferred deferred_;
+};
+
+// 训练字典的Node.js绑定：trainDictionary(samples: (string | Buffer)[], dictSize: number) => Promise<Buffer | null>
+Napi::Value TrainDictionary(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    // 参数验证
+    if (info.Length() < 2 || !info[0].IsArray() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected array and number arguments").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Array samplesArray = info[0].As<Napi::Array>();
+    size_t dictSize = static_cast<size_t>(info[1].As<Napi::Number>().Int64Value());
+
+    // 转换样本数组
+    std::vector<std::string> samples;
+    samples.reserve(samplesArray.Length());
+    for (uint32_t i = 0; i < samplesArray.Length(); i++) {
+        Napi::Value element = samplesArray[i];
+        if (element.IsString()) {
+            samples.push_back(element.As<Napi::String>().Utf8Value());
+        } else if (element.IsBuffer()) {
+            Napi::Buffer<char> buffer = element.As<Napi::Buffer<char>>();
+            samples.emplace_back(buffer.Data(), buffer.Length());
+        }
+    }
+
+    auto* worker = new TrainDictionaryWorker(env, std::move(samples), dictSize);
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+// 加载字典的Node.js绑定：loadDictionary(dict: Buffer, level: number) => number（字典 id，失败为 0）
+Napi::Value LoadDictionary(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    // 参数验证
+    if (info.Length() < 1 || !info[0].IsBuffer()) {
+        Napi::TypeError::New(env, "Expected buffer argument").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Buffer<uint8_t> dict = info[0].As<Napi::Buffer<uint8_t>>();
+    int level = 3;
+    if (info.Length() > 1 && info[1].IsNumber()) {
+        level = info[1].As<Napi::Number>().Int32Value();
+    }
+
+    uint32_t dictId = ContentCodec::LoadDictionary(dict.Data(), dict.Length(), level);
+    return Napi::Number::New(env, dictId);
+}
+
+// 压缩的Node.js绑定：compress(text: string, level?: number, useDictionary?: boolean) => Buffer | null
+Napi::Value Compress(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    // 参数验证
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected string argument").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    std::string text = info[0].As<Napi::String>().Utf8Value();
+    int level = 3;
+    if (info.Length() > 1 && info[1].IsNumber()) {
+        level = info[1].As<Napi::Number>().Int32Value();
+    }
+
+    bool useDictionary = true;
+    if (info.Length() > 2 && info[2].IsBoolean()) {
+        useDictionary = info[2].As<Napi::Boolean>().Value();
+    }
+
+    std::vector<uint8_t> packed;
+    if (!ContentCodec::Compress(text.data(), text.size(), level, packed, useDictionary)) {
+        return env.Null();
+    }
+    return Napi::Buffer<uint8_t>::Copy(env, packed.data(), packed.size());
+}
+
+// 解压的Node.js绑定：decompress(data: Buffer) => string | null
+Napi::Value Decompress(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    // 参数验证
+    if (info.Length() < 1 || !info[0].IsBuffer()) {
+        Napi::TypeError::New(env, "Expected buffer argument").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Buffer<uint8_t> data = info[0].As<Napi::Buffer<uint8_t>>();
+    std::string text;
+    if (!ContentCodec::Decompress(data.Data(), data.Length(), text)) {
+        return env.Null();
+    }
+    return Napi::String::New(env, text);
+}
+
+// 读取帧头字典 id 的Node.js绑定：dictId(data: Buffer) => number（未使用字典为 0）
+Napi::Value DictId(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    // 参数验证
+    if (info.Length() < 1 || !info[0].IsBuffer()) {
+        Napi::TypeError::New(env, "Expected buffer argument").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Buffer<uint8_t> data = info[0].As<Napi::Buffer<uint8_t>>();
+    return Napi::Number::New(env, ContentCodec::FrameDictId(data.Data(), data.Length()));
+}
+
+// 模块初始化
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set(Napi::String::New(env, "trainDictionary"), Napi::Function::New(env, TrainDictionary));
+    exports.Set(Napi::String::New(env, "loadDictionary"), Napi::Function::New(env, LoadDictionary));
+    exports.Set(Napi::String::New(env, "compress"), Napi::Function::New(env, Compress));
+    exports.Set(Napi::String::New(env, "decompress"), Napi::Function::New(env, Decompress));
+    exports.Set(Napi::String::New(env, "dictId"), Napi::Function::New(env, DictId));
+    return exports;
+}
+
+NODE_API_MODULE(content_codec, Init)
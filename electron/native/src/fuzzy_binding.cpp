@@ -0,0 +1,177 @@
+#include <napi.h>
+#include "../include/fuzzy_index.h"
+#include <memory>
+#include <string>
+#include <utility>
+
+// 当前生效的索引，只在 JS 主线程读写；后台线程构建完成后在 OnOK 中替换
+static std::shared_ptr<const FuzzyIndex> g_index;
+// 正在构建的索引：addNames 分批写入，commitIndex 生成删除索引后替换 g_index
+// 只在后台线程中修改，JS 侧保证同一时间只有一个构建任务
+static std::shared_ptr<FuzzyIndex> g_pending;
+
+/**
+ * 后台切词并加入构建中的词典，避免阻塞主线程
+ */
+class AddNamesWorker : public Napi::AsyncWorker {
+public:
+    AddNamesWorker(Napi::Env env, std::shared_ptr<FuzzyIndex> index, std::string names)
+        : Napi::AsyncWorker(env), index_(std::move(index)), names_(std::move(names)),
+          deferred_(Napi::Promise::Deferred::New(env)) {}
+
+    Napi::Promise Promise() { return deferred_.Promise(); }
+
+    void Execute() override {
+        index_->AddNames(names_);
+        termCount_ = index_->TermCount();
+    }
+
+    void OnOK() override {
+        deferred_.Resolve(Napi::Number::New(Env(), static_cast<double>(termCount_)));
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    std::shared_ptr<FuzzyIndex> index_;
+    std::string names_;
+    size_t termCount_ = 0;
+    Napi::Promise::Deferred deferred_;
+};
+
+/**
+ * 后台生成删除索引，完成后替换当前生效的索引
+ */
+class CommitIndexWorker : public Napi::AsyncWorker {
+public:
+    CommitIndexWorker(Napi::Env env, std::shared_ptr<FuzzyIndex> index)
+        : Napi::AsyncWorker(env), index_(std::move(index)), deferred_(Napi::Promise::Deferred::New(env)) {}
+
+    Napi::Promise Promise() { return deferred_.Promise(); }
+
+    void Execute() override {
+        index_->Finish();
+    }
+
+    void OnOK() override {
+        g_index = index_;
+        deferred_.Resolve(Napi::Number::New(Env(), static_cast<double>(index_->TermCount())));
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    std::shared_ptr<FuzzyIndex> index_;
+    Napi::Promise::Deferred deferred_;
+};
+
+// 分批写入文件名的Node.js绑定：addNames(names: string, reset?: boolean) => Promise<number>
+// names 为以 '\n' 分隔的一批文件名；reset 为 true 时丢弃之前未提交的构建，开始新的构建
+Napi::Value AddNames(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    // 参数验证
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected string argument").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    bool reset = info.Length() > 1 && info[1].IsBoolean() && info[1].As<Napi::Boolean>().Value();
+    if (reset || !g_pending) {
+        g_pending = std::make_shared<FuzzyIndex>();
+    }
+
+    auto* worker = new AddNamesWorker(env, g_pending, info[0].As<Napi::String>().Utf8Value());
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+// 提交构建的Node.js绑定：commitIndex() => Promise<number>，返回词典中的词数
+Napi::Value CommitIndex(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    std::shared_ptr<FuzzyIndex> index = std::move(g_pending);
+    if (!index) {
+        index = std::make_shared<FuzzyIndex>();
+    }
+
+    auto* worker = new CommitIndexWorker(env, std::move(index));
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+// 查询纠错候选的Node.js绑定：suggest(term, maxDistance?, limit?) => {term, distance, count}[]
+Napi::Value Suggest(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    // 参数验证
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected string argument").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    std::string term = info[0].As<Napi::String>().Utf8Value();
+    int maxDistance = FuzzyIndex::kMaxDistance;
+    int limit = 5;
+
+    if (info.Length() > 1 && info[1].IsNumber()) {
+        maxDistance = info[1].As<Napi::Number>().Int32Value();
+    }
+    if (info.Length() > 2 && info[2].IsNumber()) {
+        limit = info[2].As<Napi::Number>().Int32Value();
+    }
+
+    if (!g_index || limit <= 0) {
+        return Napi::Array::New(env, 0);
+    }
+
+    std::vector<FuzzyIndex::Suggestion> suggestions = g_index->Suggest(term, maxDistance, static_cast<size_t>(limit));
+
+    // 创建结果数组
+    Napi::Array resultArray = Napi::Array::New(env, suggestions.size());
+    for (size_t i = 0; i < suggestions.size(); i++) {
+        Napi::Object item = Napi::Object::New(env);
+        item.Set("term", Napi::String::New(env, suggestions[i].term));
+        item.Set("distance", Napi::Number::New(env, suggestions[i].distance));
+        item.Set("count", Napi::Number::New(env, suggestions[i].count));
+        resultArray[i] = item;
+    }
+
+    return resultArray;
+}
+
+// 前缀查询的Node.js绑定：hasPrefix(term) => boolean，词典中有以 term 开头的词时返回 true
+Napi::Value HasPrefix(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    // 参数验证
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected string argument").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    return Napi::Boolean::New(env, g_index && g_index->HasPrefix(info[0].As<Napi::String>().Utf8Value()));
+}
+
+// 索引是否已构建
+Napi::Value IsReady(const Napi::CallbackInfo& info) {
+    return Napi::Boolean::New(info.Env(), g_index != nullptr);
+}
+
+// 模块初始化
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set(Napi::String::New(env, "addNames"), Napi::Function::New(env, AddNames));
+    exports.Set(Napi::String::New(env, "commitIndex"), Napi::Function::New(env, CommitIndex));
+    exports.Set(Napi::String::New(env, "suggest"), Napi::Function::New(env, Suggest));
+    exports.Set(Napi::String::New(env, "hasPrefix"), Napi::Function::New(env, HasPrefix));
+    exports.Set(Napi::String::New(env, "isReady"), Napi::Function::New(env, IsReady));
+    return exports;
+}
+
+NODE_API_MODULE(fuzzy_search, Init)
@@ -0,0 +1,363 @@
+// 文件名模糊匹配索引（SymSpell 候选生成 + Hyyrö 位并行 OSA 距离校验）
+#include "../include/fuzzy_index.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// 解码一个 UTF-8 码点，非法字节按单字节跳过并返回 0
+char32_t DecodeUtf8(const std::string& s, size_t& i) {
+    unsigned char c = static_cast<unsigned char>(s[i]);
+    if (c < 0x80) {
+        i += 1;
+        return c;
+    }
+    int len = (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : (c >> 3) == 0x1E ? 4 : 0;
+    if (len == 0 || i + len > s.size()) {
+        i += 1;
+        return 0;
+    }
+    char32_t cp = c & (0xFF >> (len + 1));
+    for (int k = 1; k < len; k++) {
+        unsigned char cc = static_cast<unsigned char>(s[i + k]);
+        if ((cc & 0xC0) != 0x80) {
+            i += 1;
+            return 0;
+        }
+        cp = (cp << 6) | (cc & 0x3F);
+    }
+    i += len;
+    return cp;
+}
+
+void EncodeUtf8(const std::u32string& s, std::string& out) {
+    out.clear();
+    for (char32_t cp : s) {
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+}
+
+// 文件名中的分隔符：ASCII 标点/空白、通用标点、全角标点
+bool IsSeparator(char32_t cp) {
+    if (cp == 0) return true;
+    if (cp < 0x80) {
+        return !((cp >= '0' && cp <= '9') || (cp >= 'a' && cp <= 'z') || (cp >= 'A' && cp <= 'Z'));
+    }
+    return (cp >= 0x2000 && cp <= 0x206F)   // 通用标点
+        || (cp >= 0x3000 && cp <= 0x303F)   // CJK 符号和标点
+        || (cp >= 0xFF00 && cp <= 0xFF0F)   // 全角标点
+        || (cp >= 0xFF1A && cp <= 0xFF20)
+        || (cp >= 0xFF3B && cp <= 0xFF40)
+        || (cp >= 0xFF5B && cp <= 0xFF65);
+}
+
+char32_t ToLower(char32_t cp) {
+    return (cp >= 'A' && cp <= 'Z') ? cp + ('a' - 'A') : cp;
+}
+
+// 逐个输出小写词，换行符同样是分隔符，多行文本可直接切分
+template <typename Fn>
+void ForEachToken(const std::string& text, Fn&& fn) {
+    std::u32string current;
+    size_t i = 0;
+    while (i < text.size()) {
+        char32_t cp = DecodeUtf8(text, i);
+        if (IsSeparator(cp)) {
+            if (!current.empty()) {
+                fn(current);
+                current.clear();
+            }
+            continue;
+        }
+        current.push_back(ToLower(cp));
+    }
+    if (!current.empty()) {
+        fn(current);
+    }
+}
+
+} // namespace
+
+
+FuzzyIndex::BitPattern::BitPattern(const char32_t* p, size_t m) {
+    for (size_t i = 0; i < m; i++) {
+        uint64_t bit = uint64_t(1) << i;
+        char32_t c = p[i];
+        if (c < 128) {
+            ascii[c] |= bit;
+            continue;
+        }
+        auto it = std::find_if(other.begin(), other.end(), [c](const auto& e) { return e.first == c; });
+        if (it == other.end()) {
+            other.emplace_back(c, bit);
+        } else {
+            it->second |= bit;
+        }
+    }
+}
+
+
+uint64_t FuzzyIndex::BitPattern::Eq(char32_t c) const {
+    if (c < 128) return ascii[c];
+    for (const auto& e : other) {
+        if (e.first == c) return e.second;
+    }
+    return 0;
+}
+
+
+void FuzzyIndex::Tokenize(const std::string& text, std::vector<std::u32string>& out) {
+    ForEachToken(text, [&out](const std::u32string& token) { out.push_back(token); });
+}
+
+
+uint32_t FuzzyIndex::Hash(const char32_t* s, size_t n, size_t skip1, size_t skip2) {
+    // FNV-1a，哈希冲突只会带来多余的候选，最终由编辑距离校验过滤
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; i++) {
+        if (i == skip1 || i == skip2) continue;
+        h ^= static_cast<uint32_t>(s[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+
+void FuzzyIndex::CollectDeletes(const char32_t* key, size_t n, int maxDistance, std::vector<uint32_t>& hashes) {
+    // 直接跳过被删除的位置计算哈希，不实际构造删除变体
+    hashes.push_back(Hash(key, n));
+    if (maxDistance < 1 || n <= 1) return;
+    for (size_t i = 0; i < n; i++) {
+        hashes.push_back(Hash(key, n, i));
+        if (maxDistance < 2 || n <= 2) continue;
+        for (size_t j = i + 1; j < n; j++) {
+            hashes.push_back(Hash(key, n, i, j));
+        }
+    }
+}
+
+
+int FuzzyIndex::BoundedDistance(const char32_t* a, size_t m, const char32_t* b, size_t n, int maxDistance) {
+    return BoundedDistance(BitPattern(a, m), m, b, n, maxDistance);
+}
+
+
+int FuzzyIndex::BoundedDistance(const BitPattern& pattern, size_t m, const char32_t* b, size_t n, int maxDistance) {
+    const int overflow = maxDistance + 1;
+    if ((m > n ? m - n : n - m) > static_cast<size_t>(maxDistance)) return overflow;
+    if (m == 0) return static_cast<int>(n);
+
+    // Hyyrö (2003) 的位并行 OSA 距离：在 Myers 算法基础上，用 tr 标记可由相邻交换到达的位置
+    const uint64_t high = uint64_t(1) << (m - 1);
+    uint64_t vp = ~uint64_t(0);
+    uint64_t vn = 0;
+    uint64_t d0 = 0;
+    uint64_t prevEq = 0;
+    int score = static_cast<int>(m);
+
+    for (size_t j = 0; j < n; j++) {
+        const uint64_t eq = pattern.Eq(b[j]);
+        const uint64_t tr = (((~d0) & eq) << 1) & prevEq;
+        d0 = (((eq & vp) + vp) ^ vp) | eq | vn | tr;
+        uint64_t hp = vn | ~(d0 | vp);
+        uint64_t hn = d0 & vp;
+        if (hp & high) {
+            score++;
+        } else if (hn & high) {
+            score--;
+        }
+        hp = (hp << 1) | 1;
+        hn <<= 1;
+        vp = hn | ~(d0 | hp);
+        vn = hp & d0;
+        prevEq = eq;
+
+        // 剩余每个字符最多让距离减 1，已无法回到阈值内则提前结束
+        if (score - static_cast<int>(n - j - 1) > maxDistance) return overflow;
+    }
+    return score > maxDistance ? overflow : score;
+}
+
+
+void FuzzyIndex::GrowSlots() {
+    std::vector<uint32_t> slots(slots_.empty() ? 1024 : slots_.size() * 2, 0);
+    const size_t mask = slots.size() - 1;
+    for (uint32_t id = 0; id < counts_.size(); id++) {
+        size_t i = termHashes_[id] & mask;
+        while (slots[i] != 0) i = (i + 1) & mask;
+        slots[i] = id + 1;
+    }
+    slots_.swap(slots);
+}
+
+
+void FuzzyIndex::AddTerm(const std::u32string& term) {
+    // 负载因子不超过 1/2，线性探测
+    if ((counts_.size() + 1) * 2 > slots_.size()) GrowSlots();
+    const uint32_t h = Hash(term.data(), term.size());
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = h & mask;; i = (i + 1) & mask) {
+        const uint32_t slot = slots_[i];
+        if (slot == 0) {
+            slots_[i] = static_cast<uint32_t>(counts_.size()) + 1;
+            chars_.insert(chars_.end(), term.begin(), term.end());
+            termOffsets_.push_back(static_cast<uint32_t>(chars_.size()));
+            counts_.push_back(1);
+            termHashes_.push_back(h);
+            return;
+        }
+        const uint32_t id = slot - 1;
+        if (termHashes_[id] == h && TermLength(id) == term.size()
+            && std::equal(term.begin(), term.end(), TermData(id))) {
+            if (counts_[id] < UINT32_MAX) counts_[id]++;
+            return;
+        }
+    }
+}
+
+
+void FuzzyIndex::AddNames(const std::string& names) {
+    ForEachToken(names, [this](const std::u32string& token) {
+        if (token.size() < kMinTermLength || token.size() > kMaxTermLength) return;
+        AddTerm(token);
+    });
+}
+
+
+void FuzzyIndex::Finish() {
+    // 去重用的哈希表只在构建期间需要
+    std::vector<uint32_t>().swap(slots_);
+    std::vector<uint32_t>().swap(termHashes_);
+    chars_.shrink_to_fit();
+    termOffsets_.shrink_to_fit();
+    counts_.shrink_to_fit();
+
+    const uint32_t termCount = static_cast<uint32_t>(counts_.size());
+    size_t total = 0;
+    for (uint32_t id = 0; id < termCount; id++) {
+        size_t n = std::min(TermLength(id), kPrefixLength);
+        total += 1 + n + n * (n - 1) / 2;
+    }
+    // 每桶平均约 8 个条目：桶数组是索引中最大的固定开销，同桶冲突由编辑距离校验过滤
+    size_t bucketCount = 1024;
+    while (bucketCount < total / 8) bucketCount <<= 1;
+    bucketMask_ = static_cast<uint32_t>(bucketCount - 1);
+
+    // 一个词的多个删除变体落在同一个桶时只记录一次
+    std::vector<uint32_t> buckets;
+    auto collectBuckets = [this, &buckets](uint32_t id) {
+        buckets.clear();
+        CollectDeletes(TermData(id), std::min(TermLength(id), kPrefixLength), kMaxDistance, buckets);
+        for (uint32_t& b : buckets) b &= bucketMask_;
+        std::sort(buckets.begin(), buckets.end());
+        buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+    };
+
+    // 计数排序：先统计每桶条目数并求前缀和得到桶尾，再从桶尾向前填入，结束时即为桶首
+    bucketOffsets_.assign(bucketCount + 1, 0);
+    for (uint32_t id = 0; id < termCount; id++) {
+        collectBuckets(id);
+        for (uint32_t b : buckets) bucketOffsets_[b]++;
+    }
+    for (size_t b = 1; b < bucketCount; b++) {
+        bucketOffsets_[b] += bucketOffsets_[b - 1];
+    }
+    bucketOffsets_[bucketCount] = bucketOffsets_[bucketCount - 1];
+
+    bucketIds_.resize(bucketOffsets_[bucketCount]);
+    for (uint32_t id = 0; id < termCount; id++) {
+        collectBuckets(id);
+        for (uint32_t b : buckets) bucketIds_[--bucketOffsets_[b]] = id;
+    }
+
+    sortedIds_.resize(termCount);
+    for (uint32_t id = 0; id < termCount; id++) sortedIds_[id] = id;
+    std::sort(sortedIds_.begin(), sortedIds_.end(), [this](uint32_t x, uint32_t y) {
+        return std::lexicographical_compare(TermData(x), TermData(x) + TermLength(x), TermData(y), TermData(y) + TermLength(y));
+    });
+}
+
+
+bool FuzzyIndex::HasPrefix(const std::string& prefix) const {
+    std::vector<std::u32string> tokens;
+    Tokenize(prefix, tokens);
+    if (tokens.size() != 1 || sortedIds_.empty()) return false;
+
+    // 第一个不小于 prefix 的词若以 prefix 开头即命中
+    const std::u32string& query = tokens[0];
+    auto it = std::lower_bound(sortedIds_.begin(), sortedIds_.end(), query, [this](uint32_t id, const std::u32string& q) {
+        return std::lexicographical_compare(TermData(id), TermData(id) + TermLength(id), q.begin(), q.end());
+    });
+    return it != sortedIds_.end() && TermLength(*it) >= query.size()
+        && std::equal(query.begin(), query.end(), TermData(*it));
+}
+
+
+std::vector<FuzzyIndex::Suggestion> FuzzyIndex::Suggest(const std::string& term, int maxDistance, size_t limit) const {
+    std::vector<Suggestion> results;
+    std::vector<std::u32string> tokens;
+    Tokenize(term, tokens);
+    if (tokens.size() != 1 || limit == 0 || counts_.empty() || bucketOffsets_.empty()) return results;
+
+    const std::u32string& query = tokens[0];
+    if (query.size() < kMinTermLength || query.size() > kMaxTermLength) return results;
+    const int d = std::max(0, std::min(maxDistance, kMaxDistance));
+
+    // 1) 用查询词前缀的删除变体在索引中查找候选
+    std::vector<uint32_t> buckets;
+    CollectDeletes(query.data(), std::min(query.size(), kPrefixLength), d, buckets);
+    for (uint32_t& b : buckets) b &= bucketMask_;
+    std::sort(buckets.begin(), buckets.end());
+    buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+
+    std::vector<uint32_t> candidates;
+    for (uint32_t b : buckets) {
+        candidates.insert(candidates.end(),
+            bucketIds_.begin() + bucketOffsets_[b], bucketIds_.begin() + bucketOffsets_[b + 1]);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    // 2) 用完整词校验编辑距离，模式只取决于查询词，所有候选共用
+    const BitPattern pattern(query.data(), query.size());
+    std::vector<std::pair<int, uint32_t>> matched;
+    for (uint32_t id : candidates) {
+        const size_t length = TermLength(id);
+        if ((length > query.size() ? length - query.size() : query.size() - length) > static_cast<size_t>(d)) continue;
+        int distance = BoundedDistance(pattern, query.size(), TermData(id), length, d);
+        if (distance <= d) {
+            matched.emplace_back(distance, id);
+        }
+    }
+
+    std::sort(matched.begin(), matched.end(), [this](const auto& x, const auto& y) {
+        if (x.first != y.first) return x.first < y.first;
+        return counts_[x.second] > counts_[y.second];
+    });
+    if (matched.size() > limit) matched.resize(limit);
+
+    results.reserve(matched.size());
+    for (const auto& m : matched) {
+        Suggestion s;
+        EncodeUtf8(std::u32string(TermData(m.second), TermLength(m.second)), s.term);
+        s.distance = m.first;
+        s.count = counts_[m.second];
+        results.push_back(std::move(s));
+    }
+    return results;
+}
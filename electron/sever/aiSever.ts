@@ -11,6 +11,7 @@ import { INotification2 } from '../types/system.js';
 import { sendToRenderer } from '../main.js';
 import { calculateMd5 } from '../units/math.js';
 import { checkTask } from '../database/repositories.js';
+import { markFuzzyIndexStale } from '../core/fuzzyMatcher.js';
 
 /**
  * AI服务，提供文本摘要、图片摘要、问题回答
@@ -161,7 +162,7 @@ class AiSever {
             // 已经AI处理过的，不再需要OCR
             const updateStmt = this.db.prepare(`UPDATE files SET 
                 md5 = ?, size = ?, modified_at = ?,
-                full_content = ?,summary = ?,tags = ?,
+                full_content = zstd_compress(?),summary = ?,tags = ?,
                 ai_mark=1,
                 skip_ocr=1
                 WHERE path = ?`
@@ -174,12 +175,14 @@ class AiSever {
             // 没有记录，则插入一条新的记录
             const insertStmt = this.db.prepare(
                 `INSERT OR IGNORE INTO files (md5, path, name, ext, full_content,summary,tags, size, modified_at, ai_mark=1,skip_ocr=1)
-                         VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)`
+                         VALUES (?, ?, ?, ?, zstd_compress(?), ?, ?, ?, ?)`
             );
 
             const inserRes = insertStmt.run(md5, documentPath, name, ext, content, summary, tags.join(','), size, modifiedAt);
             if (inserRes.changes > 0) {
                 logger.info(`AI 标记成功: ${documentPath}`);
+                // 新入库的文件名需要加入拼写容错词典
+                markFuzzyIndexStale();
                 return true;
             }
             throw new Error(`AI 标记失败: ${documentPath}`);
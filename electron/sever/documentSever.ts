@@ -13,6 +13,7 @@ import * as fs from 'fs';
 import XLSX from 'xlsx';
 import { calculateMd5 } from '../units/math.js';
 import { checkTask } from '../database/repositories.js';
+import { markFuzzyIndexStale } from '../core/fuzzyMatcher.js';
 
 const __filename = fileURLToPath(import.meta.url);
 const __dirname = path.dirname(__filename);
@@ -112,11 +113,12 @@ class DocumentSever {
             const name = path.basename(documentPath).toLowerCase();
             const ext = path.extname(documentPath).toLowerCase();
             const md5 = calculateMd5(documentPath, size, modifiedAt);
+            const isNew = !this.db.prepare(`SELECT 1 FROM files WHERE path = ?`).get(documentPath);
 
             // 原子 UPSERT：存在即更新，不存在则插入
             const upsertStmt = this.db.prepare(`
                 INSERT INTO files (md5, path, name, ext, full_content, size, modified_at, skip_ocr)
-                VALUES (?, ?, ?, ?, ?, ?, ?, 1)
+                VALUES (?, ?, ?, ?, zstd_compress(?), ?, ?, 1)
                 ON CONFLICT(path) DO UPDATE SET
                     md5 = excluded.md5,
                     size = excluded.size,
@@ -126,6 +128,8 @@ class DocumentSever {
             `);
             const res = upsertStmt.run(md5, documentPath, name, ext, content, size, modifiedAt);
             logger.info(`文档索引成功: ${documentPath} (changes=${res.changes})`);
+            // 新入库的文件名需要加入拼写容错词典（更新不改 name，无需重建）
+            if (isNew && res.changes > 0) markFuzzyIndexStale();
             return true;
         } catch (error) {
             logger.error(`insertResult处理失败: ${error}`);
@@ -9,6 +9,7 @@ import { sendToRenderer } from '../main.js';
 import { fileURLToPath } from 'url';
 import { createWorker } from 'tesseract.js';
 import pathConfig from '../core/pathConfigs.js';
+import { markFuzzyIndexStale } from '../core/fuzzyMatcher.js';
 
 
 const __filename = fileURLToPath(import.meta.url);
@@ -197,11 +198,12 @@ export class OcrSever {
             // 计算MD5
             const metadataString = `${imagePath}-${size}-${modifiedAt}`;
             const md5 = crypto.createHash('md5').update(metadataString).digest('hex');
+            const isNew = !this.db.prepare(`SELECT 1 FROM files WHERE path = ?`).get(imagePath);
 
             // 原子 UPSERT：存在即更新，不存在则插入
             const upsertStmt = this.db.prepare(`
                 INSERT INTO files (md5, path, name, ext, full_content, size, modified_at, skip_ocr)
-                VALUES (?, ?, ?, ?, ?, ?, ?, 1)
+                VALUES (?, ?, ?, ?, zstd_compress(?), ?, ?, 1)
                 ON CONFLICT(path) DO UPDATE SET
                     md5 = excluded.md5,
                     size = excluded.size,
@@ -211,6 +213,8 @@ export class OcrSever {
             `);
             const res = upsertStmt.run(md5, imagePath, name, ext, text, size, modifiedAt);
             logger.info(`图片OCR索引成功: ${imagePath} (changes=${res.changes})`);
+            // 新入库的文件名需要加入拼写容错词典（更新不改 name，无需重建）
+            if (isNew && res.changes > 0) markFuzzyIndexStale();
 
             // const updateStmt = this.db.prepare(`UPDATE files SET md5 = ?, full_content = ?, size = ?, modified_at = ?, skip_ocr = 1 WHERE path = ?`);
             // const res = updateStmt.run(md5, text, size, modifiedAt, imagePath);
@@ -44,4 +44,5 @@ interface shortSearchResult {
         snippet?: string; // 高亮片段（可选）
     }[];
     total: number;
+    stale?: boolean; // 已被更新的按键取代，前端应忽略
 }
\ No newline at end of file
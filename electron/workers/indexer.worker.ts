@@ -4,6 +4,7 @@ import Database from 'better-sqlite3';
 import dayjs from 'dayjs';
 import fg from 'fast-glob';
 import { normalizeWinPath } from '../units/pathUtils.js';
+import { loadContentDictionaries, registerContentFunctions } from '../database/contentCodec.js';
 
 /**
  * 基础的文件信息
@@ -19,12 +20,16 @@ const ALLOWED_EXTENSIONS = 'png,jpg,jpeg,ppt,pptx,csv,doc,docx,txt,xlsx,xls,pdf,
 const BATCH_SIZE = 10000;
 
 // --- 1. 首先，获取 workerData 并初始化数据库 ---
-const { drive, dbPath } = workerData as {
+const { drive, dbPath, contentCodecPath } = workerData as {
     drive: string;
     dbPath: string;
+    contentCodecPath: string;
 };
 const db = new Database(dbPath);
 db.pragma('journal_mode = WAL');
+// files 的 FTS 触发器依赖正文压缩函数，每个连接都需要注册
+registerContentFunctions(db, contentCodecPath);
+loadContentDictionaries(db);
 
 // --- 准备好 SQL 语句 ---
 const insertStmt = db.prepare(
@@ -0,0 +1,24 @@
+import { parentPort, workerData } from 'worker_threads';
+import Database from 'better-sqlite3';
+
+/**
+ * 整库 VACUUM（存量正文压缩完成后执行一次）
+ * 已有的库设置 auto_vacuum 不会生效，必须 VACUUM 才能切换为增量回收，同时把压缩腾出的空闲页归还给文件系统
+ * VACUUM 只复制页，不经过视图与触发器，不需要注册正文压缩函数
+ */
+const { dbPath } = workerData as { dbPath: string };
+
+// 主线程偶尔有写入，等待写锁的时间放宽
+const BUSY_TIMEOUT_MS = 60 * 1000;
+
+try {
+    const db = new Database(dbPath, { timeout: BUSY_TIMEOUT_MS });
+    db.pragma('auto_vacuum = INCREMENTAL');
+    db.exec('VACUUM');
+    // WAL 模式下 VACUUM 把整库写进 WAL，检查点后截断，避免 WAL 文件与数据库一样大
+    db.pragma('wal_checkpoint(TRUNCATE)');
+    db.close();
+    parentPort?.postMessage({ status: 'success' });
+} catch (error) {
+    parentPort?.postMessage({ status: 'error', error: error instanceof Error ? error.message : String(error) });
+}
@@ -121,6 +121,8 @@ const SearchBar = () => {
     // 快捷搜索
     const onSearch = async (keyword: string, category: string = 'ALL') => {
         const res = await window.electronAPI.shortSearch(keyword, category);
+        // 已被更新的输入取代的结果直接丢弃
+        if (res.stale) return;
         console.log('快捷搜索结果', res);
         setData(res.data);
         setTotal(res.total);
@@ -39,4 +39,5 @@ type shortSearchDataItem = {
 interface shortSearchResult {
     data: shortSearchDataItem[];
     total: number;
+    stale?: boolean; // 已被更新的按键取代，应忽略
 }